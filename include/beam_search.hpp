@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   beam_search.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:12:50 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 19:12:50 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BEAM_SEARCH_HPP
+#define BEAM_SEARCH_HPP
+
+#include "simulator.hpp"
+#include "objective.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+
+// ============================================================================
+// BEAM SEARCH SOBRE PUNTOS DE DECISIÓN
+// ============================================================================
+//
+// Alternativa a GRASP que sí compara schedules parciales entre sí. Un estado
+// es (ciclo, stocks, lotes en marcha). Desde cada estado se puede lanzar en
+// lote cualquier proceso elegible (todas las instancias que caben, como el
+// simulador) o esperar a la siguiente finalización. En cada nivel se quedan
+// los width mejores por score acumulado (smart_score x instancias lanzadas).
+//
+// - Para no generar la misma tanda en distinto orden, dentro de un mismo
+//   ciclo los procesos se lanzan en orden creciente de id.
+// - Tabla de transposición: estados equivalentes (mismo hash de ciclo,
+//   stocks y lotes) se quedan solo con el de mejor score.
+// - La expansión de cada nivel se reparte entre hilos con robo de trabajo:
+//   cada hilo vacía su cola por detrás y roba de las demás por delante.
+//
+// El resultado es un Solution como el de GRASP; el mejor final es el que
+// más stock del objetivo tiene y, a igualdad, el de menor makespan.
+//
+// Con la cota LP (lp_bound.hpp) la búsqueda para en cuanto un final la
+// alcanza, y los precios sombra suman al score lo que vale para el objetivo
+// cada unidad que produce un proceso.
+
+class BeamSearch {
+private:
+    // Lote en marcha, ordenado por (finish, proc)
+    struct Batch {
+        int finish;
+        int proc;
+        int count;
+
+        bool operator<(const Batch& o) const
+        {
+            return finish != o.finish ? finish < o.finish : proc < o.proc;
+        }
+        bool operator==(const Batch& o) const
+        {
+            return finish == o.finish && proc == o.proc && count == o.count;
+        }
+    };
+
+    // Rastro de decisiones compartido: cada estado apunta a su último nodo
+    struct TrailNode {
+        int parent;
+        int time;
+        int proc;
+        int count;
+    };
+
+    struct State {
+        int time;
+        std::vector<int> stocks;
+        std::vector<Batch> running;
+        long long score;
+        int next_from;      // primer id que se puede lanzar en este ciclo
+        int trail;          // -1 = sin decisiones
+        uint64_t hash;
+        // Decisión que lo generó, pendiente de pasar al rastro
+        int parent;
+        int proc;           // -1 = espera
+        int count;
+    };
+
+    const Problem& problem;
+    int max_time;
+    int width;
+    int num_threads;
+    bool verbose;
+    int target;             // recurso objetivo, -1 si no hay
+    int target_quantity;
+    int stop_stock;         // cota del objetivo: alcanzarla termina la búsqueda
+    Objective objective;    // orden de los finales (vacío: solo target)
+    std::vector<double> shadow_prices;
+
+    // Estado de partida
+    int start_time;
+    std::vector<int> start_stocks;
+    std::vector<Batch> start_running;
+
+    // Plazo opcional
+    typedef std::chrono::steady_clock Clock;
+    static const int DEADLINE_STRIDE = 64;  // procesos entre lecturas del reloj
+    bool has_deadline;
+    Clock::time_point deadline;
+    std::atomic<bool> level_cut;            // el plazo cortó el nivel a medias
+
+    std::vector<int> static_scores;
+    std::vector<long long> shadow_bonus;    // por proceso, por instancia
+    std::vector<TrailNode> trail;
+    std::unordered_map<uint64_t, long long> transpositions;
+    std::vector<State> beam;
+    std::vector<State> finals;
+    long long expanded;
+
+    // Reparto con robo de trabajo
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+    std::vector<WorkQueue> queues;
+    std::vector<std::vector<State> > worker_children;
+    std::vector<std::thread> pool;
+    std::mutex pool_mutex;
+    std::condition_variable pool_cv;
+    std::condition_variable done_cv;
+    int generation;
+    int busy_workers;
+    bool shutting_down;
+
+public:
+    BeamSearch(const Problem& problem, int max_t = 10000);
+    ~BeamSearch();
+
+    void setWidth(int w) { width = w > 0 ? w : 1; }
+    void setThreads(int n) { num_threads = n > 0 ? n : 1; }
+    void setVerbose(bool v) { verbose = v; }
+    void setTarget(int resource, int quantity = 1);
+    // Objetivo compilado: target = recurso principal y finales comparados
+    // por el vector completo
+    void setObjective(const Objective& o);
+    // Cota superior del stock final del objetivo y precios sombra por recurso
+    void setStopStock(int stock) { stop_stock = stock; }
+    void setShadowPrices(const std::vector<double>& prices) { shadow_prices = prices; }
+    // Partir de otro estado (por defecto: stocks iniciales, nada en marcha)
+    void setStart(int time, const std::vector<int>& stocks,
+                  const std::vector<exec_process>& running);
+
+    Solution solve();
+    Solution solveFor(double seconds);
+
+    long long getExpanded() const { return expanded; }
+
+private:
+    void prepareScores();
+    // false si el plazo la cortó (los hijos quedan a medias)
+    bool expandState(const State& s, int index, std::vector<State>& out) const;
+    bool pastDeadline() const { return has_deadline && Clock::now() >= deadline; }
+    void applyCompletions(State& s) const;
+    void advance(State& s) const;
+    void drain(State& s) const;
+    bool settled(const State& s) const;
+    uint64_t hashState(const State& s) const;
+    bool better(const State& a, const State& b) const;
+    bool betterFinal(const State& a, const State& b) const;
+    void commitTrail(State& s);
+    Solution buildSolution(const State& s) const;
+
+    void expandLevel();
+    void runTasks(int worker);
+    bool takeTask(int worker, int& task);
+    void workerMain(int worker);
+    void startPool();
+    void stopPool();
+};
+
+#endif
@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bitset.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:41:07 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 20:41:07 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BITSET_HPP
+#define BITSET_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Conjunto de enteros [0, size) empaquetado en palabras de 64 bits. A
+// diferencia de std::vector<bool> deja ver las palabras, así que
+// intersecciones y recorridos van de 64 en 64 elementos.
+class Bitset
+{
+private:
+	std::vector<uint64_t> words;
+	size_t bits;
+
+public:
+	Bitset() : bits(0) {}
+
+	static size_t wordsFor(size_t n) { return (n + 63) / 64; }
+
+	// Deja n bits a 0 sin soltar la capacidad que ya tenía
+	void assign(size_t n)
+	{
+		bits = n;
+		words.assign(wordsFor(n), 0);
+	}
+
+	size_t size() const { return bits; }
+	size_t numWords() const { return words.size(); }
+	const uint64_t *data() const { return words.data(); }
+	uint64_t *data() { return words.data(); }
+
+	bool test(size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+	void set(size_t i) { words[i >> 6] |= (uint64_t)1 << (i & 63); }
+	void reset(size_t i) { words[i >> 6] &= ~((uint64_t)1 << (i & 63)); }
+
+	// ¿Algún bit en común con mask? mask son count palabras alineadas con
+	// las nuestras a partir de la palabra first. El AND va por bloques de 8
+	// palabras sin saltos dentro, que el compilador vectoriza
+	bool intersects(const uint64_t *mask, size_t first, size_t count) const
+	{
+		const uint64_t *w = words.data() + first;
+		size_t k = 0;
+		for (; k + 8 <= count; k += 8)
+		{
+			uint64_t acc = 0;
+			for (size_t j = 0; j < 8; j++)
+				acc |= w[k + j] & mask[k + j];
+			if (acc)
+				return true;
+		}
+		uint64_t acc = 0;
+		for (; k < count; k++)
+			acc |= w[k] & mask[k];
+		return acc != 0;
+	}
+
+	// Quita los elementos de other (mismo tamaño)
+	void subtract(const Bitset &other)
+	{
+		for (size_t w = 0; w < words.size(); w++)
+			words[w] &= ~other.words[w];
+	}
+
+	// Llama a f(i) por cada bit a 1, en orden. Las palabras vacías cuestan
+	// una comparación
+	template <class F>
+	void forEachSet(F &&f) const
+	{
+		for (size_t w = 0; w < words.size(); w++)
+		{
+			uint64_t bits_left = words[w];
+			while (bits_left)
+			{
+				f((w << 6) + __builtin_ctzll(bits_left));
+				bits_left &= bits_left - 1;
+			}
+		}
+	}
+};
+
+#endif
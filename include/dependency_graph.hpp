@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dependency_graph.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 12:05:37 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 12:05:37 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef DEPENDENCY_GRAPH_HPP
+#define DEPENDENCY_GRAPH_HPP
+
+#include "problem.hpp"
+
+// ============================================================================
+// GRAFO DE DEPENDENCIAS
+// ============================================================================
+//
+// Grafo bipartito productor/consumidor: nodos [0, R) son recursos y
+// [R, R + P) procesos. Aristas recurso -> proceso que lo consume y
+// proceso -> recurso que produce. Las adyacencias son los CSR del Problem.
+//
+// Los ciclos de recetas se condensan en SCCs (Tarjan) para saber qué lleva
+// al objetivo. Tiempos con semántica AND/OR (un proceso espera a todos sus
+// requisitos, un recurso al más rápido de sus productores): una pasada tipo
+// Dijkstra hacia delante da el tiempo de producción y otra hacia atrás desde
+// el objetivo el tiempo que falta; el camino crítico es la ruta más rápida
+// y la holgura de un nodo lo que se aparta de ella. Todas las consultas son
+// O(1) sobre vectores.
+//
+// Sin analyze_full_chain las consultas devuelven valores neutros.
+
+class DependencyGraph {
+public:
+    static constexpr int INF = 1 << 29;
+
+private:
+    int num_resources;
+    int num_processes;
+    int target;
+    int critical_length;    // Longitud del camino crítico hasta el objetivo
+
+    // Condensación: componente de cada nodo y DAG de componentes en CSR
+    std::vector<int> comp_of;
+    std::vector<int> comp_succ_offsets;
+    std::vector<int> comp_succ;
+    std::vector<int> comp_weight;   // Mayor delay de los procesos del SCC
+    std::vector<char> comp_relevant; // El SCC alcanza el objetivo
+
+    // Por nodo: inicio más temprano de cada proceso y tiempo mínimo desde
+    // cada nodo hasta tener el objetivo
+    std::vector<int> process_start;
+    std::vector<int> node_tail;
+
+    // Resultados por recurso
+    std::vector<int> time_to_produce;
+    std::vector<int> resource_priority;
+    std::vector<long> need;
+    std::vector<double> availability;
+    std::vector<char> bottleneck;
+
+public:
+    DependencyGraph();
+
+    // Analiza la cadena completa que lleva a target_quantity de target
+    void analyze_full_chain(int target, int target_quantity,
+                            const std::vector<int>& stocks,
+                            const Problem& problem);
+
+    bool is_analyzed() const { return !comp_of.empty(); }
+
+    // Consultas por proceso
+    bool is_process_critical(int p) const;
+    int get_process_slack(int p) const;
+
+    // Consultas por recurso
+    int get_resource_priority(int r) const;
+    bool is_on_critical_path(int r) const;
+    int get_time_to_produce(int r) const;
+    int get_critical_path_length(int r) const;
+    bool is_bottleneck(int r) const;
+    double get_availability_ratio(int r) const;
+    long get_need(int r) const;
+
+    int get_critical_path_length() const { return critical_length; }
+    int get_num_components() const { return comp_weight.size(); }
+
+private:
+    void condense(const Problem& problem);
+    void compute_time_to_produce(const std::vector<int>& stocks,
+                                 const Problem& problem);
+    void compute_critical_path(const Problem& problem);
+    void compute_needs(int target_quantity, const std::vector<int>& stocks,
+                       const Problem& problem);
+    void compute_priorities(const Problem& problem);
+
+    int node_slack(int node) const;
+    bool node_is_critical(int node) const;
+};
+
+#endif
@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   generator.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 18:04:12 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 18:04:12 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include "optimizer.hpp"
+#include <string>
+
+// ============================================================================
+// GENERADOR DE INSTANCIAS SINTÉTICAS
+// ============================================================================
+//
+// Familias de problemas escalables para medir el simulador y el optimizador.
+// Cada una devuelve el texto de una config en el formato normal, así que se
+// puede guardar en un fichero o parsear directamente. Misma semilla y mismos
+// parámetros = misma instancia.
+//
+//   chain         cadena lineal de size procesos (r0 -> r1 -> ... -> r<size>)
+//   dag           size capas de width recursos; cada proceso junta fan
+//                 recursos de la capa anterior (fan-in) y cada recurso lo
+//                 consumen varios procesos de la siguiente (fan-out)
+//   cycle         anillo de size recetas que se realimenta y genera oro;
+//                 no se agota nunca, solo lo para el límite de ciclos
+//   multiplicity  width procesos en size etapas con stocks enormes:
+//                 lanzamientos en lote de muchas instancias
+
+enum InstanceFamily {
+    CHAIN,
+    FANOUT_DAG,
+    CYCLIC,
+    MULTIPLICITY
+};
+
+struct InstanceParams {
+    InstanceFamily family;
+    int size;           // longitud / capas / etapas
+    int width;          // anchura de capa, procesos por etapa
+    int fan;            // entradas por proceso en dag
+    int stock;          // stock inicial de las materias primas
+    uint64_t seed;
+
+    InstanceParams()
+        : family(CHAIN), size(100), width(8), fan(3), stock(1000), seed(42) {}
+};
+
+class InstanceGenerator {
+private:
+    InstanceParams params;
+    Rng rng;
+    std::string out;
+
+public:
+    InstanceGenerator(const InstanceParams& params);
+
+    std::string generate();
+
+    static bool parseFamily(const std::string& name, InstanceFamily& family);
+    static const char* familyName(InstanceFamily family);
+
+private:
+    void chain();
+    void dag();
+    void cyclic();
+    void multiplicity();
+
+    void stockLine(const std::string& name, int qty);
+    void processLine(const std::string& name,
+                     const std::vector<std::pair<std::string, int> >& needs,
+                     const std::vector<std::pair<std::string, int> >& results,
+                     int delay);
+    void optimizeLine(const std::string& target);
+};
+
+#endif
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   history.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:01:19 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 15:01:19 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HISTORY_HPP
+#define HISTORY_HPP
+
+#include <vector>
+#include <algorithm>
+
+struct execution {
+    int start;
+    int end;
+    int process;
+    int count;
+};
+
+// ============================================================================
+// HISTORIAL DE EJECUCIÓN CODIFICADO EN DELTAS
+// ============================================================================
+//
+// En vez de copiar todos los stocks en cada finalización se guardan solo los
+// cambios. Los cambios se agrupan en frames: cada finalización cierra uno
+// (su snapshot es el estado justo después) y la fase de lanzamientos de cada
+// ciclo cierra otro. Dentro de un frame los cambios de un mismo recurso se
+// acumulan. Cada CHECKPOINT_EVERY frames se guarda el estado completo, así
+// que reconstruir cualquier snapshot cuesta como mucho ese número de frames.
+
+class History {
+public:
+    static const int CHECKPOINT_EVERY = 256;
+
+    // Iterador de solo avance: materializa los snapshots cuando se piden,
+    // aplicando los deltas sobre el estado que ya tiene
+    class const_iterator {
+    private:
+        const History* history;
+        size_t index;
+        mutable std::vector<int> state;
+        mutable int state_frame;    // frame al que corresponde state
+
+    public:
+        const_iterator(const History* h, size_t i)
+            : history(h), index(i), state_frame(-2) {}
+
+        const execution& operator*() const { return history->entries[index]; }
+        const execution* operator->() const { return &history->entries[index]; }
+        const_iterator& operator++() { index++; return *this; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+
+        // Stocks justo después de esta finalización
+        const std::vector<int>& snapshot() const;
+    };
+
+private:
+    struct Frame {
+        int time;
+        int delta_begin;
+    };
+
+    int num_resources;
+    std::vector<execution> entries;
+    std::vector<int> entry_frame;       // frame que cerró cada entrada
+    std::vector<Frame> frames;
+    std::vector<int> delta_resources;
+    std::vector<int> delta_amounts;
+    std::vector<int> checkpoints;       // estado antes del frame c * CHECKPOINT_EVERY
+
+    // Frame abierto
+    std::vector<int> current;
+    std::vector<int> pending_pos;       // recurso -> posición en los deltas abiertos
+    int open_begin;
+
+public:
+    History();
+
+    void reset(const std::vector<int>& initial_stocks);
+
+    // El simulador avisa de cada cambio de stock
+    void onChange(int resource, int delta)
+    {
+        if (delta == 0)
+            return;
+        current[resource] += delta;
+        if (pending_pos[resource] < 0) {
+            pending_pos[resource] = delta_resources.size();
+            delta_resources.push_back(resource);
+            delta_amounts.push_back(delta);
+        } else {
+            delta_amounts[pending_pos[resource]] += delta;
+        }
+    }
+
+    // Cierra el frame abierto (si tiene cambios) con el instante dado
+    void seal(int time);
+
+    // Registra una finalización; su snapshot es el estado actual
+    void record(const execution& e, int time);
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const execution& operator[](size_t i) const { return entries[i]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, entries.size()); }
+
+    // Reconstrucción bajo demanda
+    std::vector<int> snapshot(size_t i) const;
+    std::vector<int> stocksAt(int cycle) const;
+
+    // Memoria aproximada en bytes (para comparar con los snapshots completos)
+    size_t memoryUsage() const;
+
+private:
+    void closeFrame(int time);
+    // Deja en out el estado después del frame f (f = -1: stocks iniciales),
+    // partiendo de out si ya estaba en from_frame <= f
+    void advance(std::vector<int>& out, int& from_frame, int f) const;
+};
+
+#endif
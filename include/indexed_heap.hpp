@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   indexed_heap.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:20:40 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 11:20:40 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <vector>
+
+// Max-heap de ids densos [0, n) con su posición indexada, para poder borrar
+// o cambiar la clave de cualquier elemento en O(log n).
+// A igualdad de clave sale antes el id menor (orden determinista).
+template <typename Key>
+class IndexedHeap
+{
+private:
+	std::vector<int> heap;   // ids
+	std::vector<int> pos;    // posición en heap, -1 si no está
+	std::vector<Key> keys;
+
+	bool before(int a, int b) const
+	{
+		if (keys[a] != keys[b])
+			return keys[a] > keys[b];
+		return a < b;
+	}
+
+	void place(size_t i, int id)
+	{
+		heap[i] = id;
+		pos[id] = i;
+	}
+
+	void siftUp(size_t i)
+	{
+		int id = heap[i];
+		while (i > 0)
+		{
+			size_t parent = (i - 1) / 2;
+			if (!before(id, heap[parent]))
+				break;
+			place(i, heap[parent]);
+			i = parent;
+		}
+		place(i, id);
+	}
+
+	void siftDown(size_t i)
+	{
+		int id = heap[i];
+		size_t n = heap.size();
+		while (2 * i + 1 < n)
+		{
+			size_t child = 2 * i + 1;
+			if (child + 1 < n && before(heap[child + 1], heap[child]))
+				child++;
+			if (!before(heap[child], id))
+				break;
+			place(i, heap[child]);
+			i = child;
+		}
+		place(i, id);
+	}
+
+public:
+	IndexedHeap(int n = 0) { reset(n); }
+
+	void reset(int n)
+	{
+		heap.clear();
+		pos.assign(n, -1);
+		keys.assign(n, Key());
+	}
+
+	bool empty() const { return heap.empty(); }
+	size_t size() const { return heap.size(); }
+	bool contains(int id) const { return pos[id] >= 0; }
+	int top() const { return heap[0]; }
+	Key key(int id) const { return keys[id]; }
+	const std::vector<int> &items() const { return heap; }
+
+	void push(int id, Key key)
+	{
+		if (contains(id))
+		{
+			update(id, key);
+			return;
+		}
+		keys[id] = key;
+		heap.push_back(id);
+		siftUp(heap.size() - 1);
+	}
+
+	void pop() { erase(heap[0]); }
+
+	void erase(int id)
+	{
+		size_t i = pos[id];
+		int last = heap.back();
+		heap.pop_back();
+		pos[id] = -1;
+		if (last == id)
+			return;
+		place(i, last);
+		siftUp(i);
+		siftDown(pos[last]);
+	}
+
+	// Sube o baja el elemento según la nueva clave
+	void update(int id, Key key)
+	{
+		Key old = keys[id];
+		keys[id] = key;
+		if (key > old)
+			siftUp(pos[id]);
+		else
+			siftDown(pos[id]);
+	}
+
+	void clear()
+	{
+		for (int id : heap)
+			pos[id] = -1;
+		heap.clear();
+	}
+};
+
+#endif
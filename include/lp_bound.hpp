@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lp_bound.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:40:12 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 19:40:12 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LP_BOUND_HPP
+#define LP_BOUND_HPP
+
+#include "problem.hpp"
+#include <utility>
+
+// ============================================================================
+// SIMPLEX DENSO
+// ============================================================================
+//
+// max c·x  sujeto a  A x <= b,  x >= 0,  con b >= 0 (el origen es factible,
+// no hace falta fase 1). Tableau denso con una holgura por restricción;
+// pivota con Dantzig y pasa a Bland si se atasca en pivotes degenerados,
+// así que no cicla. Los precios sombra salen de la fila objetivo.
+
+class SimplexLP {
+public:
+    enum Status { OPTIMAL, UNBOUNDED, ITERATION_LIMIT };
+
+private:
+    struct Row {
+        std::vector<std::pair<int, double> > coefs;
+        double rhs;
+    };
+
+    int num_vars;
+    std::vector<double> objective;
+    std::vector<Row> rows;
+
+    // Tableau (filas + 1) x (variables + holguras + 1); la última fila es
+    // la objetivo (z_j - c_j) y la última columna el término independiente
+    int stride;
+    std::vector<double> tableau;
+    std::vector<int> basis;
+
+    double& at(int i, int j) { return tableau[(size_t)i * stride + j]; }
+    double at(int i, int j) const { return tableau[(size_t)i * stride + j]; }
+
+public:
+    static constexpr double EPS = 1e-9;
+
+    explicit SimplexLP(int num_vars);
+
+    void setObjective(int var, double c) { objective[var] = c; }
+    // sum(coefs) <= rhs; devuelve el índice de la restricción
+    int addConstraint(const std::vector<std::pair<int, double> >& coefs, double rhs);
+
+    Status solve(int max_pivots);
+
+    double value() const;
+    double primal(int var) const;
+    double dual(int row) const;     // precio sombra de la restricción
+    double slack(int row) const;
+
+    int numRows() const { return rows.size(); }
+    // Celdas que ocuparía el tableau (para descartar problemas enormes)
+    static size_t tableauCells(int vars, int rows)
+    {
+        return (size_t)(rows + 1) * (size_t)(vars + rows + 1);
+    }
+
+private:
+    void pivot(int row, int col);
+};
+
+// ============================================================================
+// COTA DE PRODUCCIÓN DEL OBJETIVO
+// ============================================================================
+//
+// Relajación del problema de scheduling: x_p = ejecuciones de p dentro del
+// horizonte. Para cada recurso consumido lo gastado no puede superar lo
+// inicial más lo producido:
+//
+//     sum_p (req_pr - prod_pr) x_p <= stock_r
+//
+// y solo pueden ejecutarse procesos que, con su tiempo mínimo de arranque
+// (DependencyGraph) más su delay, terminan dentro del horizonte. Se maximiza
+// el stock final del objetivo (solo con los procesos aguas arriba de él,
+// los demás no le aportan nada). Cualquier schedule real cumple todo esto, así
+// que el óptimo es una cota superior; dividido por el horizonte es el ritmo
+// máximo sostenible. Si un ciclo de recetas se realimenta con ganancia neta
+// el LP no está acotado y no hay cota finita.
+
+struct ThroughputResult {
+    enum Status { BOUNDED, UNBOUNDED, SKIPPED };
+
+    Status status;
+    int horizon;
+    double max_stock;                   // stock final máximo del objetivo
+    double rate;                        // ganancia máxima por ciclo
+    std::vector<double> shadow_prices;  // por recurso (0 si no limita)
+    std::vector<int> binding;           // recursos limitantes, por precio
+    std::vector<double> runs;           // ejecuciones de cada proceso
+
+    ThroughputResult() : status(SKIPPED), horizon(0), max_stock(0), rate(0) {}
+
+    // Cota entera (los stocks son enteros)
+    int stockBound() const;
+    // Distancia relativa de achieved a la cota, en [0, 1]
+    double gap(int achieved) const;
+};
+
+class ThroughputBound {
+private:
+    const Problem& problem;
+    int horizon;
+
+public:
+    // Tableau a partir del cual no se intenta (memoria y tiempo)
+    static const size_t MAX_CELLS = 1 << 22;
+
+    ThroughputBound(const Problem& problem, int horizon = 10000);
+
+    ThroughputResult compute(int target) const;
+};
+
+#endif
@@ -0,0 +1,44 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mapped_file.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:48:05 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:48:05 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+
+// Fichero de solo lectura mapeado en memoria. Si no se puede mapear (tubería,
+// fichero vacío...) se lee entero a un buffer propio; para quien lo usa es
+// igual: view() da el contenido completo mientras el objeto viva.
+class MappedFile
+{
+private:
+	const char *data;
+	size_t length;
+	bool mapped;
+	std::string fallback;
+
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	// false si no se puede abrir o leer
+	bool open(const std::string &path);
+	void close();
+
+	std::string_view view() const { return std::string_view(data, length); }
+	size_t size() const { return length; }
+};
+
+#endif
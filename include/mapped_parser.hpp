@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mapped_parser.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:12:30 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:12:30 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MAPPED_PARSER_HPP
+#define MAPPED_PARSER_HPP
+
+#include "problem.hpp"
+#include <string_view>
+
+// Parser rápido para configs grandes: mapea el fichero en memoria, lo recorre
+// con string_view y from_chars y mete los ids directamente en las tablas del
+// Problem. Acepta el mismo formato que Parser y también se salta (avisando
+// con el número de línea) las líneas mal formadas.
+class MappedParser
+{
+private:
+	struct Item
+	{
+		std::string_view name;
+		int qty;
+	};
+
+	Problem &problem;
+	std::vector<char> declared;        // recurso con línea de stock propia
+	std::vector<Item> needs;           // buffers reutilizados entre líneas
+	std::vector<Item> results;
+	int errors;
+
+public:
+	MappedParser(Problem &out);
+
+	// false si no se puede leer el fichero
+	bool parse(const std::string &path);
+	// Parsea un buffer ya en memoria
+	void parseBuffer(std::string_view data);
+
+	int getErrors() const { return errors; }
+
+private:
+	void parseLine(std::string_view line, size_t line_no);
+	void parseStockLine(std::string_view line, size_t colon);
+	bool parseProcessLine(std::string_view line);
+	void parseOptimizeLine(std::string_view line);
+	bool parseItems(std::string_view content, std::vector<Item> &out);
+	void appendItems(const std::vector<Item> &items, std::vector<int> &resources,
+		std::vector<int> &amounts);
+};
+
+#endif
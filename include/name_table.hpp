@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   name_table.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:12:30 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:12:30 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef NAME_TABLE_HPP
+#define NAME_TABLE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// Tabla hash de direccionamiento abierto nombre -> id. Los nombres viven en
+// un vector externo (el id es su índice) y se busca con string_view, así que
+// consultar no crea ningún std::string temporal.
+class NameTable
+{
+private:
+	std::vector<int> slots;   // id o -1; tamaño potencia de 2
+	size_t count;
+
+	size_t probe(std::string_view key, const std::vector<std::string> &names) const
+	{
+		size_t mask = slots.size() - 1;
+		size_t i = hash(key) & mask;
+		while (slots[i] >= 0 && names[slots[i]] != key)
+			i = (i + 1) & mask;
+		return i;
+	}
+
+	void grow(const std::vector<std::string> &names)
+	{
+		std::vector<int> old;
+		old.swap(slots);
+		slots.assign(old.empty() ? 64 : old.size() * 2, -1);
+		for (int id : old)
+			if (id >= 0)
+				slots[probe(names[id], names)] = id;
+	}
+
+public:
+	NameTable() : count(0) {}
+
+	// FNV-1a de 64 bits; también sirve para huellas de ficheros enteros
+	static uint64_t hash(std::string_view key)
+	{
+		uint64_t h = 1469598103934665603ULL;
+		for (unsigned char c : key)
+		{
+			h ^= c;
+			h *= 1099511628211ULL;
+		}
+		return h;
+	}
+
+	int find(std::string_view key, const std::vector<std::string> &names) const
+	{
+		if (slots.empty())
+			return -1;
+		return slots[probe(key, names)];
+	}
+
+	// Devuelve el id existente o añade key al final de names
+	int insert(std::string_view key, std::vector<std::string> &names)
+	{
+		if ((count + 1) * 2 > slots.size())
+			grow(names);
+		size_t i = probe(key, names);
+		if (slots[i] >= 0)
+			return slots[i];
+		slots[i] = names.size();
+		names.emplace_back(key);
+		count++;
+		return slots[i];
+	}
+
+	// Indexa names[id], que ya está en el vector. Si el nombre se repite se
+	// queda el primer id
+	void index(int id, const std::vector<std::string> &names)
+	{
+		if ((count + 1) * 2 > slots.size())
+			grow(names);
+		size_t i = probe(names[id], names);
+		if (slots[i] >= 0)
+			return;
+		slots[i] = id;
+		count++;
+	}
+
+	void clear()
+	{
+		slots.clear();
+		count = 0;
+	}
+};
+
+#endif
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   objective.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:05:31 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 20:05:31 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef OBJECTIVE_HPP
+#define OBJECTIVE_HPP
+
+#include "problem.hpp"
+#include <limits>
+
+// ============================================================================
+// OBJETIVO COMPILADO DE "optimize:"
+// ============================================================================
+//
+// La lista de optimize: pasa a un vector de objetivos: los recursos a
+// maximizar en el orden del fichero (el primero manda) más la marca de
+// minimizar el tiempo si aparece "time". Cada recurso tiene una cota
+// superior opcional (la del LP) y se precalcula qué procesos alimentan a
+// algún objetivo, que es lo que permite saber en O(1) por evento cuándo
+// el objetivo ya no puede mejorar.
+
+class Objective {
+public:
+    static constexpr int NO_BOUND = std::numeric_limits<int>::max();
+
+private:
+    std::vector<int> resources;     // por prioridad
+    std::vector<int> slot_of;       // recurso -> posición en resources, -1
+    std::vector<int> bounds;        // por posición
+    std::vector<char> feeds;        // proceso -> alimenta algún objetivo
+    bool minimize_time;
+
+public:
+    Objective();
+
+    static Objective compile(const Problem& problem);
+
+    // Procesos de los que depende (transitivamente) producir algún recurso
+    // de targets. Los demás solo pueden quitarles stock
+    static std::vector<char> upstreamOf(const Problem& problem,
+                                        const std::vector<int>& targets);
+
+    bool empty() const { return resources.empty() && !minimize_time; }
+    bool hasResources() const { return !resources.empty(); }
+    bool minimizesTime() const { return minimize_time; }
+    int primary() const { return resources.empty() ? -1 : resources[0]; }
+    const std::vector<int>& getResources() const { return resources; }
+
+    int slot(int resource) const { return slot_of[resource]; }
+    bool feedsObjective(int proc) const { return feeds[proc] != 0; }
+
+    void setBound(int resource, int bound);
+    int getBound(int resource) const;
+
+    // Comparación lexicográfica de dos resultados: stocks de los objetivos
+    // por prioridad y después el tiempo (si se minimiza)
+    bool better(const std::vector<int>& a_stocks, int a_time,
+                const std::vector<int>& b_stocks, int b_time) const;
+
+    // Motor por defecto: sin presupuesto de tiempo se simula; con él, beam
+    // si hay recursos que maximizar y GRASP si solo cuenta el makespan
+    const char* preferredEngine(bool has_delay) const;
+};
+
+#endif
@@ -13,11 +13,21 @@
 #ifndef OPTIMIZER_HPP
 #define OPTIMIZER_HPP
 
-#include "parser.hpp"
+#include "problem.hpp"
+#include "resource_profile.hpp"
+#include "objective.hpp"
+#include "bitset.hpp"
+#include "requirement_matrix.hpp"
 #include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include <cstdint>
 #include <limits>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 // ============================================================================
 // ESTRUCTURAS DE DATOS
@@ -25,22 +35,43 @@
 
 // Representa una actividad programada en el schedule
 struct ScheduledActivity {
-    std::string process_name;
+    int process;      // id del proceso en el Problem
     int start_time;
     int finish_time;
+    int count;        // instancias lanzadas juntas (GRASP: siempre 1)
     
-    ScheduledActivity() : start_time(0), finish_time(0) {}
-    ScheduledActivity(std::string name, int start, int finish) 
-        : process_name(name), start_time(start), finish_time(finish) {}
+    ScheduledActivity() : process(-1), start_time(0), finish_time(0), count(1) {}
+    ScheduledActivity(int proc, int start, int finish, int n = 1)
+        : process(proc), start_time(start), finish_time(finish), count(n) {}
 };
 
 // Representa una solución completa (schedule)
 struct Solution {
     std::vector<ScheduledActivity> schedule;  // Lista de actividades programadas
     int makespan;                              // Tiempo total (duración del proyecto)
-    std::map<std::string, int> final_stocks;  // Stocks finales
+    std::vector<int> final_stocks;             // Stocks finales (por id de recurso)
+    bool complete;                             // false si se cortó por tiempo
     
-    Solution() : makespan(std::numeric_limits<int>::max()) {}
+    Solution() : makespan(std::numeric_limits<int>::max()), complete(true) {}
+};
+
+// Generador SplitMix64: barato de sembrar, así cada iteración tiene su propio
+// flujo derivado de (semilla, iteración) sin depender del hilo que la ejecute
+struct Rng {
+    uint64_t state;
+    
+    explicit Rng(uint64_t seed) : state(seed) {}
+    Rng(uint64_t seed, uint64_t stream) : state(seed ^ (stream * 0xD1B54A32D192ED03ULL)) { next(); }
+    
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    // Entero uniforme en [0, n)
+    int below(int n) { return (int)(next() % (uint64_t)n); }
 };
 
 // ============================================================================
@@ -55,6 +86,13 @@ enum PriorityRule {
     RANDOM  // Random (para diversidad)
 };
 
+// Esquema de generación del schedule en la fase constructiva
+enum ScheduleScheme {
+    SERIAL_SGS,     // un proceso por ciclo, cada proceso una sola vez
+    PARALLEL_SGS    // en cada finalización se llenan todos los huecos
+                    // factibles; los procesos se pueden repetir
+};
+
 // ============================================================================
 // GRASP OPTIMIZER
 // ============================================================================
@@ -62,75 +100,216 @@ enum PriorityRule {
 class GraspOptimizer {
 private:
     // Datos del problema
-    const std::vector<Process>& processes;
-    std::map<std::string, int> initial_stocks;
+    const Problem& problem;
+    std::vector<int> initial_stocks;
     int max_time;  // Tiempo máximo de simulación
     
+    // Productores de cada recurso como bitset sobre los procesos. Solo se
+    // guardan las palabras entre el primer y el último productor: las de r
+    // son producer_words[producer_spans[r].offset, + count) y empiezan en la
+    // palabra first del conjunto de procesos
+    struct ProducerSpan {
+        int first;
+        int count;
+        int offset;
+    };
+    std::vector<ProducerSpan> producer_spans;
+    std::vector<uint64_t> producer_words;
+    
+    // Requisitos por bloques para calcular de una pasada qué procesos
+    // caben en los stocks (kernel SIMD elegido al arrancar)
+    RequirementMatrix requirements;
+    
     // Parámetros GRASP
     int num_iterations;     // Número de iteraciones GRASP
     double alpha;           // Parámetro RCL (0.0 = greedy puro, 1.0 = random puro)
+    uint64_t seed;          // Semilla base; cada iteración deriva su Rng de ella
+    int num_threads;        // Hilos para solve() (1 = secuencial)
+    bool verbose;           // Progreso por stdout
+    ScheduleScheme scheme;
+    
+    // Objetivo de optimize:. Con recursos que maximizar los candidatos se
+    // comparan por sus stocks (y después por makespan) y el SGS paralelo
+    // solo lanza procesos que los alimentan
+    Objective objective;
+    
+    // Precios sombra del LP (lp_bound.hpp): lo que produce cada proceso
+    // valorado a esos precios, normalizado a [0, 1]. Vacío sin precios
+    std::vector<double> shadow_prices;
+    std::vector<double> shadow_value;   // por proceso
+    static constexpr double SHADOW_RANK_WEIGHT = 10.0;  // en GRPW
+    static constexpr double SHADOW_TIE_WEIGHT = 0.5;    // en las reglas enteras
+    
+    // Presupuesto de tiempo de pared (solveFor)
+    typedef std::chrono::steady_clock Clock;
+    static const unsigned DEADLINE_STRIDE = 256;  // pasos entre lecturas del reloj
+    static constexpr int LOCAL_SEARCH_COST = 4;   // FBI ~ este múltiplo de construir
+    bool has_deadline;
+    Clock::time_point deadline;
+    std::atomic<bool> time_up;
     
-    // Mejor solución encontrada
+    // Cota del objetivo (lp_bound.hpp): un schedule completo que la alcanza
+    // no se puede mejorar en stock y termina la búsqueda. Sin plazo los
+    // resultados se incorporan en orden de iteración, así que el incumbente
+    // es el mejor de [0, B] (B = primera iteración que la alcanza) con
+    // cualquier número de hilos. Las que acaban fuera de orden esperan en
+    // una ventana circular de huecos reservada al empezar; un hilo no coge
+    // una iteración que no cabe en ella hasta que avanza next_commit
+    struct CommitSlot {
+        Solution solution;      // intercambiada con el candidato, sin copia
+        int iter;               // -1 = libre
+        bool better;            // mejoraba al incumbente al llegar
+    };
+    int stop_resource;
+    int stop_stock;
+    std::atomic<int> bound_iteration;   // menor iteración que la alcanzó
+    std::vector<CommitSlot> window;     // hueco de iter = iter % tamaño
+    int next_commit;                    // siguiente iteración a incorporar
+    std::condition_variable commit_cv;  // next_commit o bound_iteration cambian
+    
+    // Mejor solución encontrada (compartida entre hilos)
     Solution best_solution;
+    int best_iteration;
+    std::atomic<int> best_makespan;   // Copia sin lock para descartar rápido
+    std::mutex best_mutex;
     
 public:
-    GraspOptimizer(const std::vector<Process>& procs, 
-                   const std::map<std::string, int>& stocks,
-                   int max_t = 10000);
+    GraspOptimizer(const Problem& problem, int max_t = 10000);
     
     // Método principal - ejecuta GRASP y devuelve la mejor solución
     Solution solve(int iterations = 100, double alpha_param = 0.3);
     
+    // Igual pero iterando hasta agotar seconds de tiempo de pared. Devuelve
+    // siempre el mejor schedule encontrado hasta ese momento
+    Solution solveFor(double seconds, double alpha_param = 0.3);
+    
+    // Setters
+    void setSeed(uint64_t s) { seed = s; }
+    void setThreads(int n) { num_threads = n > 0 ? n : 1; }
+    void setVerbose(bool v) { verbose = v; }
+    void setScheme(ScheduleScheme s) { scheme = s; }
+    void setObjective(const Objective& o) { objective = o; }
+    // Con precios los recursos limitantes pesan en las prioridades
+    void setShadowPrices(const std::vector<double>& prices) { shadow_prices = prices; }
+    void setStopStock(int resource, int stock)
+    {
+        stop_resource = resource;
+        stop_stock = stock;
+    }
+    
     // Getters
     const Solution& getBestSolution() const { return best_solution; }
     
 private:
+    // Memoria de trabajo de un hilo. Se reutiliza entre iteraciones: cuando
+    // los buffers ya tienen su tamaño, construir y mejorar una solución no
+    // reserva memoria. El incumbente solo se copia cuando mejora
+    struct Workspace {
+        Solution candidate;
+        Bitset scheduled;
+        Bitset ready;               // máscara de readyMask
+        std::vector<std::pair<int, int> > running;  // (inicio, proceso)
+        std::vector<int> eligible;
+        std::vector<std::pair<int, double> > candidates;
+        std::vector<int> rcl;
+        ResourceProfile profile;
+        std::vector<int> order;
+        std::vector<int> procs;
+        std::vector<int> starts;
+        
+        explicit Workspace(const Problem& problem) : profile(problem) {}
+    };
+    
+    // Ejecuta la iteración iter con su propio Rng y la ofrece como incumbente
+    void runIteration(int iter, Workspace& ws);
+    // Puede quedarse con los buffers de candidate (los cambia por otros)
+    void offerSolution(Solution& candidate, int iter);
+    bool orderedCommit() const { return stop_resource >= 0 && !has_deadline; }
+    // false si iter ya no hace falta; espera a que quepa en la ventana
+    bool waitForSlot(int iter);
+    // Con best_mutex cogido
+    bool beatsIncumbent(const Solution& candidate, int iter) const;
+    void acceptSolution(Solution& candidate, int iter, bool take);
+    void commitInOrder(Solution& candidate, int iter);
+    void workerLoop(std::atomic<int>& next_iter, std::atomic<int>& completed);
+    Solution runWorkers(int iterations);
+    void prepareShadowValues();
+    
+    // Comprobación barata del plazo: el reloj solo se lee cada
+    // DEADLINE_STRIDE llamadas (tick es el contador del que llama)
+    bool deadlineReached(unsigned& tick);
+    
+
     // ========================================================================
     // FASE CONSTRUCTIVA (Greedy Randomizado con Serial SGS)
     // ========================================================================
     
-    // Construye una solución usando Serial SGS con randomización
-    Solution constructGreedySolution(PriorityRule rule, double alpha);
+    // Construye en ws.candidate una solución usando Serial SGS con
+    // randomización
+    void constructGreedySolution(PriorityRule rule, double alpha, Rng& rng,
+                                 Workspace& ws);
+    
+    // Igual con Parallel SGS: el tiempo salta de finalización en
+    // finalización, así que el coste depende de las decisiones y no de
+    // max_time. ws.running hace de montículo de (fin, proceso)
+    void constructParallelSolution(PriorityRule rule, double alpha, Rng& rng,
+                                   Workspace& ws);
+    
+    // ¿Todos los recursos objetivo han llegado a su cota?
+    bool objectiveBounded(const std::vector<int>& stocks) const;
+    
+    // ¿Es candidate mejor que el incumbente (iteración best_iteration)?
+    bool betterThanBest(const Solution& candidate, int iter) const;
+    
+    // Aplica las finalizaciones de ws.running hasta current_time
+    void finishRunning(Workspace& ws, int current_time) const;
     
     // Calcula la prioridad de un proceso según la regla
-    double calculatePriority(const Process& proc, 
-                            const std::map<std::string, int>& current_stocks,
+    double calculatePriority(int proc, 
+                            const std::vector<int>& current_stocks,
                             int current_time,
-                            PriorityRule rule) const;
+                            PriorityRule rule,
+                            Rng& rng) const;
     
-    // Obtiene los procesos elegibles en un momento dado
-    std::vector<const Process*> getEligibleProcesses(
-        const std::map<std::string, int>& current_stocks,
-        const std::vector<bool>& scheduled) const;
+    // Deja en eligible los procesos elegibles en un momento dado; ready es
+    // el buffer de la máscara de stocks
+    void getEligibleProcesses(const std::vector<int>& current_stocks,
+                              const Bitset& scheduled,
+                              Bitset& ready,
+                              std::vector<int>& eligible) const;
     
-    // Selecciona un proceso de la RCL (Restricted Candidate List)
-    const Process* selectFromRCL(const std::vector<const Process*>& eligible,
-                                 const std::map<std::string, int>& current_stocks,
-                                 int current_time,
-                                 PriorityRule rule,
-                                 double alpha) const;
+    // Selecciona un proceso de la RCL (Restricted Candidate List), -1 si no
+    // hay. Usa los buffers candidates y rcl de ws
+    int selectFromRCL(const std::vector<int>& eligible,
+                      const std::vector<int>& current_stocks,
+                      int current_time,
+                      PriorityRule rule,
+                      double alpha,
+                      Rng& rng,
+                      Workspace& ws) const;
     
     // Verifica si un proceso tiene suficientes recursos
-    bool hasResourcesFor(const Process& proc, 
-                        const std::map<std::string, int>& stocks) const;
+    bool hasResourcesFor(int proc, 
+                        const std::vector<int>& stocks) const;
     
-    // Verifica si las dependencias están satisfechas
-    bool areDependenciesSatisfied(const Process& proc,
-                                  const std::vector<bool>& scheduled,
-                                  const std::map<std::string, int>& stocks) const;
+    // Verifica si las dependencias están satisfechas: cada requisito sin
+    // stock necesita un productor ya programado (AND de bitsets)
+    bool areDependenciesSatisfied(int proc,
+                                  const Bitset& scheduled,
+                                  const std::vector<int>& stocks) const;
     
     // ========================================================================
     // FASE DE MEJORA LOCAL (Forward-Backward Improvement)
     // ========================================================================
     
     // Mejora una solución usando FBI
-    void localSearch(Solution& solution);
+    void localSearch(Solution& solution, Workspace& ws);
     
     // Forward pass: intenta adelantar cada actividad
-    bool forwardPass(Solution& solution);
+    bool forwardPass(Solution& solution, Workspace& ws);
     
     // Backward pass: intenta retrasar actividades sin afectar el makespan
-    bool backwardPass(Solution& solution);
+    bool backwardPass(Solution& solution, Workspace& ws);
     
     // Verifica si un schedule es factible
     bool isScheduleFeasible(const Solution& solution) const;
@@ -140,26 +319,26 @@ private:
     // ========================================================================
     
     // Actualiza los stocks después de iniciar un proceso
-    void consumeResources(std::map<std::string, int>& stocks, 
-                         const Process& proc) const;
+    void consumeResources(std::vector<int>& stocks, 
+                         int proc) const;
     
     // Actualiza los stocks después de terminar un proceso
-    void produceResources(std::map<std::string, int>& stocks, 
-                         const Process& proc) const;
+    void produceResources(std::vector<int>& stocks, 
+                         int proc) const;
     
     // Calcula el makespan de una solución
     int calculateMakespan(const Solution& solution) const;
     
-    // Busca un proceso por nombre
-    const Process* findProcess(const std::string& name) const;
+    // Busca un proceso por nombre (-1 si no existe)
+    int findProcess(const std::string& name) const;
     
     // Calcula el slack de un proceso (para MTS rule)
-    int calculateSlack(const Process& proc,
-                      const std::map<std::string, int>& current_stocks,
+    int calculateSlack(int proc,
+                      const std::vector<int>& current_stocks,
                       int current_time) const;
     
     // Calcula el rank de un proceso (para GRPW rule)
-    double calculateRank(const Process& proc) const;
+    double calculateRank(int proc) const;
 };
 
 #endif
\ No newline at end of file
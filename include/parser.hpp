@@ -68,6 +68,7 @@ public:
 		for (auto& p : this->processes)
 			if (processname == p.name)
 				return &p;
+		return nullptr;
 	}
 
 	std::vector<Process>& getAllProcesses(){
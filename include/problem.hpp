@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   problem.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:02:11 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 10:02:11 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROBLEM_HPP
+#define PROBLEM_HPP
+
+#include "parser.hpp"
+#include "name_table.hpp"
+#include <limits>
+
+// ============================================================================
+// PROBLEMA COMPILADO
+// ============================================================================
+//
+// Representación densa del problema que se genera justo después de
+// Parser::parse. Los recursos y procesos se identifican por un índice entero
+// y los stocks son un vector plano indexado por id de recurso. Los nombres
+// solo se usan en la frontera de entrada/salida.
+//
+// Requisitos y productos se guardan en formato CSR: los del proceso p están
+// en [req_offsets[p], req_offsets[p + 1]) de req_resources / req_amounts.
+
+struct Problem
+{
+	// Recursos
+	std::vector<std::string> resource_names;
+	NameTable resource_ids;
+	std::vector<int> initial_stocks;
+
+	// Procesos
+	std::vector<std::string> process_names;
+	NameTable process_ids;
+	std::vector<int> delays;
+
+	std::vector<int> req_offsets;
+	std::vector<int> req_resources;
+	std::vector<int> req_amounts;
+
+	std::vector<int> prod_offsets;
+	std::vector<int> prod_resources;
+	std::vector<int> prod_amounts;
+
+	// Índice inverso: procesos que consumen el recurso r están en
+	// [consumer_offsets[r], consumer_offsets[r + 1]) de consumer_procs
+	std::vector<int> consumer_offsets;
+	std::vector<int> consumer_procs;
+	// Ídem para los procesos que producen el recurso r
+	std::vector<int> producer_offsets;
+	std::vector<int> producer_procs;
+
+	// Objetivos de "optimize:" tal cual vienen del fichero
+	std::vector<std::string> optimizations;
+
+	static Problem compile(Parser &parser);
+
+	int internResource(std::string_view name);
+	void addProcess(const Process &proc);
+	// Construye los índices derivados; llamar después de añadir los procesos
+	void buildIndexes();
+	void indexProcessNames();
+
+	// Devuelve -1 si el nombre no existe
+	int resourceId(std::string_view name) const;
+	int processId(std::string_view name) const;
+
+	int numResources() const { return (int)resource_names.size(); }
+	int numProcesses() const { return (int)process_names.size(); }
+	int numConsumers(int resource) const
+	{
+		return consumer_offsets[resource + 1] - consumer_offsets[resource];
+	}
+	int numProducers(int resource) const
+	{
+		return producer_offsets[resource + 1] - producer_offsets[resource];
+	}
+
+	bool hasStocksFor(int proc, const std::vector<int> &stocks) const
+	{
+		for (int k = req_offsets[proc]; k < req_offsets[proc + 1]; k++)
+			if (stocks[req_resources[k]] < req_amounts[k])
+				return false;
+		return true;
+	}
+	void consume(int proc, std::vector<int> &stocks) const
+	{
+		for (int k = req_offsets[proc]; k < req_offsets[proc + 1]; k++)
+			stocks[req_resources[k]] -= req_amounts[k];
+	}
+	void produce(int proc, std::vector<int> &stocks) const
+	{
+		for (int k = prod_offsets[proc]; k < prod_offsets[proc + 1]; k++)
+			stocks[prod_resources[k]] += prod_amounts[k];
+	}
+	bool consumes(int proc, int resource) const;
+	bool consumesStock(int proc) const;
+	// Cuántas instancias de proc caben a la vez en los stocks dados
+	int maxRuns(int proc, const std::vector<int> &stocks) const;
+	bool producesResource(int proc, int resource) const;
+
+	// Conversión a nombres para la salida
+	std::map<std::string, int> namedStocks(const std::vector<int> &stocks) const;
+};
+
+#endif
@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   problem_cache.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:48:05 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:48:05 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROBLEM_CACHE_HPP
+#define PROBLEM_CACHE_HPP
+
+#include "problem.hpp"
+#include <cstdint>
+
+// ============================================================================
+// CACHÉ BINARIA DEL PROBLEMA COMPILADO
+// ============================================================================
+//
+// Volcado del Problem ya compilado (stocks, CSR de procesos, índices inversos
+// y objetivos de optimize:) para no volver a parsear el texto en cada
+// arranque. Cargarlo es mapear el fichero y copiar bloques de enteros.
+//
+// Formato (enteros nativos, la caché es para la máquina que la genera):
+//   Header
+//   int32 initial_stocks[R], delays[P]
+//   int32 req_offsets[P + 1], req_resources[NR], req_amounts[NR]
+//   int32 prod_offsets[P + 1], prod_resources[NP], prod_amounts[NP]
+//   int32 consumer_offsets[R + 1], consumer_procs[NR]
+//   int32 producer_offsets[R + 1], producer_procs[NP]
+//   tablas de strings (recursos, procesos, optimize): int32 offsets[n + 1]
+//   seguidos de los caracteres concatenados
+//
+// source_hash es el FNV-1a del fichero de texto de origen: si no coincide
+// con el del fichero actual la caché está obsoleta.
+
+class ProblemCache
+{
+public:
+	static const uint32_t VERSION = 1;
+
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t header_size;
+		uint64_t source_hash;
+		uint64_t payload_size;
+		int32_t num_resources;
+		int32_t num_processes;
+		int32_t num_requisites;
+		int32_t num_products;
+		int32_t num_optimizations;
+		int32_t reserved;
+	};
+
+	static uint64_t hashSource(std::string_view content);
+
+	// ¿Empieza el fichero con la firma de la caché?
+	static bool isCache(const std::string &path);
+
+	static bool write(const std::string &path, const Problem &problem,
+		uint64_t source_hash);
+
+	// Deja el problema en out. Falla (y deja out vacío) si el fichero no es
+	// una caché de esta versión, está truncado o, con expected_hash != 0,
+	// si se generó a partir de otro contenido
+	static bool load(const std::string &path, Problem &out,
+		uint64_t expected_hash = 0);
+};
+
+#endif
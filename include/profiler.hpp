@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profiler.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 18:31:27 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 18:31:27 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <string>
+
+// ============================================================================
+// PERFILADOR DE LAS RUTAS CALIENTES
+// ============================================================================
+//
+// Con KRPSIM_PROFILE definido (make PROFILE=1) cada PROFILE_SCOPE cuenta
+// llamadas y tiempo de pared de su fase, y un operator new global atribuye
+// las reservas de memoria a la fase más interna activa en ese hilo. El
+// tiempo es inclusivo: smart_score también cuenta dentro de
+// executableProcesses_Smart. Sin la macro todo esto desaparece: la macro
+// queda vacía y no se sustituye operator new.
+
+enum ProfilePhase {
+    PROF_CHECK_RUNNING,
+    PROF_EXECUTABLE_SMART,
+    PROF_SMART_SCORE,
+    PROF_CONSTRUCT_GREEDY,
+    PROF_ELIGIBLE,
+    PROF_SELECT_RCL,
+    PROF_LOCAL_SEARCH,
+    PROF_NUM_PHASES
+};
+
+class Profiler {
+public:
+#ifdef KRPSIM_PROFILE
+    static const bool enabled = true;
+
+    class Scope {
+    private:
+        int phase;
+        int previous;
+        long long start;
+    public:
+        explicit Scope(ProfilePhase phase);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Vuelca el JSON en path al salir del programa (atexit)
+    static void dumpAtExit(const std::string& path);
+    static bool dump(const std::string& path);
+#else
+    static const bool enabled = false;
+
+    static void dumpAtExit(const std::string&) {}
+    static bool dump(const std::string&) { return false; }
+#endif
+};
+
+#ifdef KRPSIM_PROFILE
+# define PROFILE_CONCAT_(a, b) a##b
+# define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+# define PROFILE_SCOPE(phase) Profiler::Scope PROFILE_CONCAT(profile_scope_, __LINE__)(phase)
+#else
+# define PROFILE_SCOPE(phase) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   requirement_matrix.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:34:50 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 21:34:50 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REQUIREMENT_MATRIX_HPP
+#define REQUIREMENT_MATRIX_HPP
+
+#include "problem.hpp"
+#include "bitset.hpp"
+
+// ============================================================================
+// MATRIZ DE REQUISITOS POR BLOQUES (SoA)
+// ============================================================================
+//
+// Para saber qué procesos pueden empezar con unos stocks dados se comparan
+// los requisitos de todos a la vez. Los procesos se agrupan en bloques de
+// LANES consecutivos y cada bloque guarda sus requisitos por filas: la fila
+// k tiene el k-ésimo requisito de cada proceso del bloque, con los recursos
+// y las cantidades en dos arrays separados. Así una fila es un vector de
+// LANES enteros que se compara de golpe con los stocks (gather + cmpgt).
+// Un bloque tiene tantas filas como el proceso con más requisitos; los
+// huecos piden INT_MIN del recurso 0 y nunca fallan.
+//
+// Una matriz densa proceso x recurso no cabe en los problemas grandes (5k x
+// 5k enteros son 100 MB), mientras que esta ocupa O(requisitos).
+//
+// El kernel se elige al construir: AVX2 si la CPU lo tiene, si no SSE2 en
+// x86-64 y escalar en el resto. El binario se compila sin -mavx2; solo las
+// funciones del kernel llevan el atributo target.
+
+class RequirementMatrix {
+public:
+    static const int LANES = 8;
+
+    enum Isa { SCALAR, SSE2, AVX2 };
+
+    explicit RequirementMatrix(const Problem& problem, Isa isa = bestIsa());
+
+    // Mejor conjunto de instrucciones disponible en esta CPU
+    static Isa bestIsa();
+    static const char* isaName(Isa isa);
+    Isa getIsa() const { return isa; }
+
+    // Deja en ready (tamaño numProcesses) el bit p a 1 si los stocks
+    // cubren todos los requisitos de p
+    void readyMask(const std::vector<int>& stocks, Bitset& ready) const;
+
+private:
+    typedef void (*Kernel)(const RequirementMatrix& m, const int* stocks, uint64_t* words);
+
+    int num_processes;
+    int num_blocks;
+    std::vector<int> row_offsets;   // filas del bloque b: [row_offsets[b], row_offsets[b + 1])
+    std::vector<int> resources;     // fila * LANES + carril
+    std::vector<int> amounts;
+    Isa isa;
+    Kernel kernel;
+
+    static void scalarKernel(const RequirementMatrix& m, const int* stocks, uint64_t* words);
+    static void sse2Kernel(const RequirementMatrix& m, const int* stocks, uint64_t* words);
+    static void avx2Kernel(const RequirementMatrix& m, const int* stocks, uint64_t* words);
+};
+
+#endif
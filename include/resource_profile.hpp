@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   resource_profile.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:10:02 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 14:02:45 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RESOURCE_PROFILE_HPP
+#define RESOURCE_PROFILE_HPP
+
+#include "problem.hpp"
+#include <limits>
+
+// ============================================================================
+// PERFIL DE RECURSOS DE UN SCHEDULE
+// ============================================================================
+//
+// Nivel de stock de cada recurso en cada instante [0, horizon] para un
+// schedule: los requisitos se consumen al empezar y los productos se suman
+// al terminar. El schedule es factible si ningún nivel es negativo.
+//
+// Cada recurso consumido tiene un árbol de segmentos dinámico sobre el
+// tiempo con suma en rango y mínimo en rango. Los nodos se crean solo donde
+// hay eventos, así que la memoria es O(eventos x log H) y no O(H); todas las
+// operaciones son O(log H). Los recursos que solo se producen no se siguen:
+// nunca pueden quedar en negativo.
+
+class ResourceProfile {
+private:
+    // min incluye el add del propio nodo; un hijo ausente vale 0
+    struct Node {
+        int min;
+        int add;
+        int left;
+        int right;
+    };
+
+    const Problem& problem;
+    int horizon;
+    int width;                  // horizon + 1
+    std::vector<int> row_of;    // recurso -> fila, -1 si no se sigue
+    int num_rows;
+    std::vector<int> roots;     // raíz del árbol de cada fila
+    std::vector<Node> nodes;
+
+public:
+    ResourceProfile(const Problem& problem);
+
+    // Reconstruye el perfil: starts[i] es el inicio de procs[i]
+    void build(const std::vector<int>& initial_stocks,
+               const std::vector<int>& procs,
+               const std::vector<int>& starts,
+               int horizon);
+
+    // Añade (sign = 1) o quita (sign = -1) una actividad
+    void addActivity(int proc, int start, int sign);
+
+    // ¿Algún nivel negativo en todo el horizonte? O(filas)
+    bool feasible() const;
+
+    // ¿Puede empezar una nueva actividad de proc en t sin dejar ningún
+    // stock en negativo después? O(requisitos x log H)
+    bool canStartAt(int proc, int t) const;
+
+    // Primer t >= from en el que canStartAt es cierto, -1 si no hay
+    int earliestStart(int proc, int from) const;
+
+    // Mueve una actividad de start a new_start si el perfil sigue siendo
+    // factible; si no, lo deja como estaba
+    bool tryShift(int proc, int start, int new_start);
+
+    // Inicio más temprano (<= start) al que se puede adelantar la actividad
+    int earliestShift(int proc, int start) const;
+
+    // Inicio más tardío al que se puede retrasar sin terminar después de limit
+    int latestShift(int proc, int start, int limit) const;
+
+    int getHorizon() const { return horizon; }
+
+private:
+    int newNode();
+    int childMin(int idx) const { return idx < 0 ? 0 : nodes[idx].min; }
+    void update(int node, int l, int r, int a, int b, int delta);
+    int queryMin(int node, int l, int r, int a, int b, int acc) const;
+    int lastBelow(int node, int l, int r, int a, int b, int q, int acc) const;
+    int firstBelow(int node, int l, int r, int a, int b, int q, int acc) const;
+
+    void addRange(int row, int from, int to, int delta);
+    int minRange(int row, int from, int to) const;
+    void shift(int proc, int start, int new_start, int sign);
+};
+
+#endif
@@ -13,64 +13,167 @@
 #ifndef SIMULATOR_HPP
 #define SIMULATOR_HPP
 
-#include "parser.hpp"
+#include "problem.hpp"
 #include "optimizer.hpp"
+#include "indexed_heap.hpp"
+#include "dependency_graph.hpp"
+#include "history.hpp"
+#include "trace_writer.hpp"
+#include "objective.hpp"
 
+// Lote de count instancias de proc lanzadas a la vez: termina como un evento
 struct exec_process
 {
-	Process proc;
+	int proc;
 	int start;
+	int count;
 };
 
-struct execution {
-    int start;
-    int end;
-    std::string process_name;
-    std::map<std::string, int> stocks_snapshot;
+// Lanzamiento registrado mientras se busca un periodo (para repetir la traza)
+struct period_start
+{
+	int time;
+	int proc;
+	int count;
+};
+
+// Evento de finalización: el handle es el índice del hueco en process_executing
+struct completion_event
+{
+	int finish;
+	int handle;
+
+	bool operator>(const completion_event &other) const
+	{
+		if (finish != other.finish)
+			return finish > other.finish;
+		return handle > other.handle;
+	}
 };
 
 class Simulator {
 private:
+    const Problem& problem;
     int	time;
     int max_cycles;
-    std::vector<execution> history;
-    std::map<std::string, int> stocks_now;
-    std::vector<Process> process_pending;
-    std::vector<exec_process> process_executing;
-    Parser info;
+    History history;
+    bool record_history;
+    TraceWriter* trace;           // nullptr = sin traza
+    std::vector<int> stocks_now;
+    std::vector<int> process_pending;
+    std::vector<exec_process> process_executing;  // huecos indexados por handle
+    std::vector<int> free_handles;
+    std::priority_queue<completion_event, std::vector<completion_event>,
+                        std::greater<completion_event> > events;
+    int running_count;            // lotes en ejecución
+    long long event_count;        // lanzamientos de lote + finalizaciones
+    long long instance_count;     // instancias lanzadas
+    
+    // Elegibilidad incremental: solo se revisan los procesos que consumen
+    // algún recurso cuyo stock ha cambiado
+    std::vector<char> dirty_flag;
+    std::vector<int> dirty_list;
+    IndexedHeap<int> ready_heap;  // listos, ordenados por smart_score
+    
+    // Parte estática del score, calculada una vez tras analyze_full_chain
+    std::vector<int> static_scores;
+    bool target_reached;
     
     // Para optimización
     DependencyGraph dep_graph;
-    std::string target_stock;
+    int target_stock;  // id de recurso, -1 si no hay objetivo
     int target_quantity;
 	bool liquidation_mode;
     
+    // Objetivo de optimize: seguido por eventos en O(1). La simulación para
+    // cuando todos los recursos objetivo llegan a su cota o cuando no queda
+    // en marcha ningún lote que los alimente (y no se puede lanzar ninguno)
+    Objective objective;
+    bool objective_active;
+    int objective_open;     // recursos objetivo por debajo de su cota
+    int feeding_running;    // lotes en marcha que alimentan el objetivo
+    
+    // Régimen periódico: si el estado que decide la simulación (stocks de
+    // los recursos que alguien consume u objetivo, lotes en marcha relativos
+    // al ciclo actual y target_reached) se repite, todo lo que sigue se
+    // repite también y se puede saltar de golpe. Ciclo de Brent sobre los
+    // puntos de decisión: memoria O(1) estados
+    bool fast_forward;
+    bool ff_done;
+    std::vector<char> ff_relevant;     // recurso que influye en decisiones
+    uint64_t ff_stock_hash;            // XOR incremental de stocks relevantes
+    long long ff_power;
+    long long ff_lambda;
+    bool ff_has_mark;
+    uint64_t ff_mark_hash;
+    int ff_mark_time;
+    std::vector<int> ff_mark_signature;
+    std::vector<int> ff_mark_stocks;
+    long long ff_mark_events;
+    long long ff_mark_instances;
+    std::vector<period_start> ff_starts;   // lanzamientos desde la marca
+    std::vector<int> ff_signature;         // buffer reutilizado
+    
 public:
-    Simulator(Parser P);
+    Simulator(const Problem& problem);
     void simulate();
+    // Análisis del objetivo + scores estáticos (simulate lo hace al empezar);
+    // para otros motores que quieran puntuar con las mismas heurísticas
+    void prepareScores();
+    const std::vector<int>& getStaticScores() const { return static_scores; }
+    // smart_score a partir de la parte estática
+    static int adjustedScore(int static_score, bool target_reached);
     
     // Setters
-    void setTargetStock(const std::string& target) { target_stock = target; }
+    void setTargetStock(const std::string& target) { target_stock = problem.resourceId(target); }
     void setTargetQuantity(int qty) { target_quantity = qty; }
+    // Objetivo compilado: fija el recurso principal, su cantidad (la cota si
+    // la hay) y activa la parada anticipada
+    void setObjective(const Objective& o);
     void setMaxCycles(int max) { max_cycles = max; }
+    void setTrace(TraceWriter* writer) { trace = writer; }
+    // Sin historial la memoria no crece con la duración de la simulación
+    void setRecordHistory(bool record) { record_history = record; }
+    // Salto de periodos (solo sin historial); activado por defecto
+    void setFastForward(bool enabled) { fast_forward = enabled; }
     
     // Getters
-    const std::vector<execution>& getHistory() const { return history; }
-    const std::map<std::string, int>& getStocksNow() const { return stocks_now; }
+    const History& getHistory() const { return history; }
+    const std::vector<int>& getStockVector() const { return stocks_now; }
+    std::map<std::string, int> getStocksNow() const { return problem.namedStocks(stocks_now); }
     int getCurrentTime() const { return time; }
+    int getRunningCount() const { return running_count; }
+    long long getEventCount() const { return event_count; }
+    long long getInstanceCount() const { return instance_count; }
     
     // Métodos de simulación
-    bool haveStocksFor(Process to_do);
-    bool start_execution(const Process& to_do);
-    void end_execution(std::string process_n);
-    void substractStocks(std::string stock, int amount);
-    void addStocks(std::string stock, int amount);
-    std::vector<Process> executableProcesses();
+    bool haveStocksFor(int proc) const;
+    int start_execution(int proc);
+    void end_execution(int handle);
+    void substractStocks(int stock, int amount);
+    void addStocks(int stock, int amount);
+    std::vector<int> executableProcesses();
     void checkRunningProcs();
     
 private:
-    std::vector<Process> executableProcesses_Smart();
-    int smart_score(const Process& p);
+    void markConsumersDirty(int resource);
+    void markDirty(int proc);
+    void refreshReady();
+    void checkTarget();
+    void onObjectiveChange(int resource, int before);
+    int countOpenObjectives() const;
+    bool objectiveSettled();
+    std::vector<int> executableProcesses_Smart();
+    void computeStaticScores();
+    int static_score(int p);
+    int smart_score(int p) const;
+    
+    void initSteadyState();
+    void updateStockHash(int resource, int before);
+    uint64_t stateHash() const;
+    void buildSignature(std::vector<int>& out) const;
+    void observeSteadyState();
+    void fastForwardPeriods(int period);
 };
 
 #endif
\ No newline at end of file
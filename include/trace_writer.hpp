@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_writer.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:40:52 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 15:40:52 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TRACE_WRITER_HPP
+#define TRACE_WRITER_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Escritor en streaming de la traza "ciclo:proceso". Acumula en un buffer
+// fijo y lo vuelca en bloques grandes: sin flush por línea y sin guardar
+// nada más, así que la memoria no depende de la longitud de la ejecución.
+class TraceWriter
+{
+public:
+	static const size_t BUFFER_SIZE = 1 << 20;
+
+private:
+	FILE *out;
+	bool owns;
+	std::vector<char> buffer;
+	size_t used;
+	size_t lines;
+
+public:
+	TraceWriter(FILE *out = stdout);
+	~TraceWriter();
+
+	// Redirige la salida a un fichero; false si no se puede abrir
+	bool open(const std::string &path);
+
+	// Escribe count líneas "cycle:name"
+	void write(int cycle, const std::string &name, int count = 1);
+	void flush();
+
+	size_t getLines() const { return lines; }
+
+private:
+	TraceWriter(const TraceWriter &);
+	TraceWriter &operator=(const TraceWriter &);
+};
+
+#endif
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verifier.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:20:41 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 17:20:41 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef VERIFIER_HPP
+#define VERIFIER_HPP
+
+#include "problem.hpp"
+#include <queue>
+
+// ============================================================================
+// VERIFICADOR DE TRAZAS
+// ============================================================================
+//
+// Reproduce una traza "ciclo:proceso" sobre un problema sin simular ciclo a
+// ciclo: cada línea es un lanzamiento y las finalizaciones pendientes van en
+// un heap, así que cada evento cuesta O(log n) más sus requisitos. Las
+// líneas idénticas seguidas (lanzamientos en lote) se aplican de una vez.
+// Igual que en el simulador, lo que termina en t está disponible para lo
+// que se lanza en t, salvo lo de delay 0: termina en el ciclo en que
+// empieza y sus productos llegan en el siguiente.
+
+class Verifier {
+private:
+    struct Completion {
+        long long arrival;       // ciclo en que sus productos están disponibles
+        int proc;
+        long long count;
+
+        bool operator>(const Completion& other) const
+        {
+            return arrival > other.arrival;
+        }
+    };
+
+    const Problem& problem;
+    std::vector<long long> stocks;
+    std::priority_queue<Completion, std::vector<Completion>,
+                        std::greater<Completion> > events;
+    long long cycle;             // ciclo de la última línea aplicada
+    long long end_time;          // última finalización
+    size_t lines;                // líneas de lanzamiento leídas
+    size_t error_line;           // 0 = sin error
+    std::string error;
+
+public:
+    Verifier(const Problem& problem);
+
+    // Aplica la traza completa; false en la primera línea imposible.
+    // Las líneas que no empiezan por un dígito (cabeceras, resumen) se
+    // ignoran
+    bool run(std::string_view trace);
+
+    const std::vector<long long>& getStocks() const { return stocks; }
+    long long getEndTime() const { return end_time; }
+    long long getCycle() const { return cycle; }
+    size_t getLines() const { return lines; }
+    size_t getErrorLine() const { return error_line; }
+    const std::string& getError() const { return error; }
+
+private:
+    void completeUntil(long long t);
+    // count lanzamientos de proc en el ciclo t desde la línea first_line
+    bool start(int proc, long long t, long long count, size_t first_line);
+    bool fail(size_t line_no, const std::string& message);
+};
+
+#endif
@@ -0,0 +1,495 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   beam_search.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:12:50 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 19:12:50 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/beam_search.hpp"
+#include <cmath>
+
+// Tamaño máximo de la tabla de transposición antes de vaciarla
+static const size_t MAX_TRANSPOSITIONS = 1 << 22;
+// Puntos de score por unidad de objetivo que vale lo producido
+static const double SHADOW_SCALE = 100.0;
+
+BeamSearch::BeamSearch(const Problem& problem, int max_t)
+    : problem(problem), max_time(max_t), width(64), num_threads(1), verbose(true),
+      target(-1), target_quantity(1), stop_stock(std::numeric_limits<int>::max()),
+      start_time(0),
+      start_stocks(problem.initial_stocks), has_deadline(false), level_cut(false), expanded(0),
+      generation(0), busy_workers(0), shutting_down(false)
+{
+}
+
+BeamSearch::~BeamSearch()
+{
+    stopPool();
+}
+
+void BeamSearch::setTarget(int resource, int quantity)
+{
+    target = resource;
+    target_quantity = quantity;
+}
+
+void BeamSearch::setObjective(const Objective& o)
+{
+    objective = o;
+    if (o.hasResources())
+        setTarget(o.primary(), o.getBound(o.primary()));
+}
+
+void BeamSearch::setStart(int time, const std::vector<int>& stocks,
+                          const std::vector<exec_process>& running)
+{
+    start_time = time;
+    start_stocks = stocks;
+    start_running.clear();
+    for (const exec_process& e : running)
+        if (e.proc >= 0)
+            start_running.push_back(Batch{e.start + problem.delays[e.proc], e.proc, e.count});
+    std::sort(start_running.begin(), start_running.end());
+}
+
+// Mismos scores estáticos que el simulador
+void BeamSearch::prepareScores()
+{
+    Simulator sim(problem);
+    if (target >= 0) {
+        sim.setTargetStock(problem.resource_names[target]);
+        sim.setTargetQuantity(target_quantity);
+    }
+    sim.prepareScores();
+    static_scores = sim.getStaticScores();
+
+    // Valor en sombra de lo que produce cada proceso (el objetivo vale 1)
+    shadow_bonus.assign(problem.numProcesses(), 0);
+    if (shadow_prices.empty())
+        return;
+    for (int p = 0; p < problem.numProcesses(); p++) {
+        double value = 0;
+        for (int k = problem.prod_offsets[p]; k < problem.prod_offsets[p + 1]; k++) {
+            int r = problem.prod_resources[k];
+            double price = r == target ? 1.0 : shadow_prices[r];
+            value += price * problem.prod_amounts[k];
+        }
+        shadow_bonus[p] = std::llround(value * SHADOW_SCALE);
+    }
+}
+
+// ============================================================================
+// ESTADOS
+// ============================================================================
+
+static uint64_t mix(uint64_t h, uint64_t v)
+{
+    h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    return h * 0xBF58476D1CE4E5B9ULL;
+}
+
+uint64_t BeamSearch::hashState(const State& s) const
+{
+    uint64_t h = mix((uint64_t)s.time, (uint64_t)s.next_from);
+    for (int v : s.stocks)
+        h = mix(h, (uint32_t)v);
+    for (const Batch& b : s.running)
+        h = mix(mix(mix(h, (uint32_t)b.finish), (uint32_t)b.proc), (uint32_t)b.count);
+    return h;
+}
+
+// Orden total (determinista con cualquier número de hilos)
+bool BeamSearch::better(const State& a, const State& b) const
+{
+    if (a.score != b.score)
+        return a.score > b.score;
+    if (a.time != b.time)
+        return a.time < b.time;
+    if (a.hash != b.hash)
+        return a.hash < b.hash;
+    if (a.parent != b.parent)
+        return a.parent < b.parent;
+    return a.proc < b.proc;
+}
+
+bool BeamSearch::betterFinal(const State& a, const State& b) const
+{
+    if (objective.hasResources()) {
+        if (objective.better(a.stocks, a.time, b.stocks, b.time))
+            return true;
+        if (objective.better(b.stocks, b.time, a.stocks, a.time))
+            return false;
+    }
+    if (target >= 0 && a.stocks[target] != b.stocks[target])
+        return a.stocks[target] > b.stocks[target];
+    if (a.time != b.time)
+        return a.time < b.time;
+    return better(a, b);
+}
+
+// Aplica los lotes que terminan en s.time o antes
+void BeamSearch::applyCompletions(State& s) const
+{
+    size_t done = 0;
+    while (done < s.running.size() && s.running[done].finish <= s.time) {
+        const Batch& b = s.running[done];
+        for (int k = problem.prod_offsets[b.proc]; k < problem.prod_offsets[b.proc + 1]; k++) {
+            long long total = (long long)s.stocks[problem.prod_resources[k]]
+                            + (long long)problem.prod_amounts[k] * b.count;
+            s.stocks[problem.prod_resources[k]] =
+                (int)std::min<long long>(total, std::numeric_limits<int>::max());
+        }
+        done++;
+    }
+    s.running.erase(s.running.begin(), s.running.begin() + done);
+}
+
+// Salta a la siguiente finalización y aplica todas las de ese ciclo. Avanza
+// al menos un ciclo, como el simulador: un lote de delay 0 termina en el
+// ciclo en que empieza y sus productos llegan en el siguiente
+void BeamSearch::advance(State& s) const
+{
+    s.time = std::max(s.time + 1, s.running.front().finish);
+    applyCompletions(s);
+    s.next_from = 0;
+}
+
+// Deja terminar todo lo que está en marcha
+void BeamSearch::drain(State& s) const
+{
+    while (!s.running.empty())
+        advance(s);
+}
+
+// Como en el simulador: el objetivo ya no puede mejorar si todos sus
+// recursos están en la cota o si nada de lo que los alimenta está en marcha
+// ni se puede lanzar
+bool BeamSearch::settled(const State& s) const
+{
+    if (!objective.hasResources())
+        return false;
+    bool all_bounded = true;
+    for (int r : objective.getResources())
+        all_bounded = all_bounded && s.stocks[r] >= objective.getBound(r);
+    if (all_bounded || (target >= 0 && s.stocks[target] >= stop_stock))
+        return true;
+    for (const Batch& b : s.running)
+        if (objective.feedsObjective(b.proc))
+            return false;
+    for (int p = 0; p < problem.numProcesses(); p++)
+        if (objective.feedsObjective(p) && problem.hasStocksFor(p, s.stocks))
+            return false;
+    return true;
+}
+
+bool BeamSearch::expandState(const State& s, int index, std::vector<State>& out) const
+{
+    bool any = false;
+
+    if (s.time < max_time && !settled(s)) {
+        bool reached = target >= 0 && s.stocks[target] >= target_quantity;
+        for (int p = s.next_from; p < problem.numProcesses(); p++) {
+            if ((p - s.next_from) % DEADLINE_STRIDE == DEADLINE_STRIDE - 1 && pastDeadline())
+                return false;
+            int max_runs = problem.maxRuns(p, s.stocks);
+            if (max_runs == 0)
+                continue;
+            // Todas las que caben (como el simulador) o una sola, dejando
+            // stock para otros procesos y la opción de lanzar más de p
+            int options[2] = {max_runs, 1};
+            for (int o = 0; o < (max_runs > 1 ? 2 : 1); o++) {
+                int count = options[o];
+                State child = s;
+                for (int k = problem.req_offsets[p]; k < problem.req_offsets[p + 1]; k++)
+                    child.stocks[problem.req_resources[k]] -= problem.req_amounts[k] * count;
+                Batch b{s.time + problem.delays[p], p, count};
+                child.running.insert(std::upper_bound(child.running.begin(),
+                                                      child.running.end(), b), b);
+                child.score += ((long long)Simulator::adjustedScore(static_scores[p], reached)
+                                + shadow_bonus[p]) * count;
+                child.next_from = count == max_runs ? p + 1 : p;
+                child.parent = index;
+                child.proc = p;
+                child.count = count;
+                child.hash = hashState(child);
+                out.push_back(std::move(child));
+            }
+            any = true;
+        }
+
+        if (!s.running.empty()) {
+            State child = s;
+            advance(child);
+            child.parent = index;
+            child.proc = -1;
+            child.count = 0;
+            child.hash = hashState(child);
+            out.push_back(std::move(child));
+            any = true;
+        }
+    }
+
+    // Sin nada que hacer (o fuera de horizonte): estado final
+    if (!any) {
+        State final_state = s;
+        final_state.parent = index;
+        final_state.proc = -2;
+        out.push_back(std::move(final_state));
+    }
+    return true;
+}
+
+void BeamSearch::commitTrail(State& s)
+{
+    if (s.proc < 0)
+        return;
+    trail.push_back(TrailNode{s.trail, s.time, s.proc, s.count});
+    s.trail = trail.size() - 1;
+}
+
+Solution BeamSearch::buildSolution(const State& s) const
+{
+    Solution solution;
+    std::vector<int> nodes;
+    for (int n = s.trail; n >= 0; n = trail[n].parent)
+        nodes.push_back(n);
+
+    solution.makespan = 0;
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        const TrailNode& node = trail[*it];
+        int finish = node.time + problem.delays[node.proc];
+        solution.schedule.push_back(ScheduledActivity(node.proc, node.time, finish, node.count));
+        solution.makespan = std::max(solution.makespan, finish);
+    }
+    solution.final_stocks = s.stocks;
+    return solution;
+}
+
+// ============================================================================
+// BÚSQUEDA
+// ============================================================================
+
+Solution BeamSearch::solve()
+{
+    has_deadline = false;
+    return solveFor(-1);
+}
+
+Solution BeamSearch::solveFor(double seconds)
+{
+    if (seconds >= 0) {
+        has_deadline = true;
+        deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+    prepareScores();
+    trail.clear();
+    transpositions.clear();
+    expanded = 0;
+
+    State root;
+    root.time = start_time;
+    root.stocks = start_stocks;
+    root.running = start_running;
+    root.score = 0;
+    root.next_from = 0;
+    root.trail = -1;
+    root.parent = -1;
+    root.proc = -1;
+    root.count = 0;
+    // Lo que termina justo en el ciclo de partida ya está disponible
+    applyCompletions(root);
+    root.hash = hashState(root);
+
+    beam.clear();
+    beam.push_back(root);
+    bool has_best = false;
+    State best;
+
+    if (verbose)
+        std::cout << "Iniciando beam search (anchura=" << width
+                  << ", hilos=" << num_threads << ")...\n";
+
+    startPool();
+    int level = 0;
+    while (!beam.empty()) {
+        if (!pastDeadline())
+            expandLevel();
+
+        // Sin tiempo (antes o a mitad del nivel): los hijos se descartan y
+        // los estados del haz terminan lo que tienen en marcha
+        if (level_cut || pastDeadline()) {
+            for (State& s : beam) {
+                drain(s);
+                if (!has_best || betterFinal(s, best)) {
+                    best = s;
+                    has_best = true;
+                }
+            }
+            break;
+        }
+        expanded += beam.size();
+
+        std::vector<State> children;
+        for (auto& part : worker_children)
+            for (State& c : part)
+                children.push_back(std::move(c));
+        std::sort(children.begin(), children.end(),
+                  [this](const State& a, const State& b) { return better(a, b); });
+
+        if (transpositions.size() > MAX_TRANSPOSITIONS)
+            transpositions.clear();
+
+        std::vector<State> next;
+        for (State& c : children) {
+            if (c.proc == -2) {
+                drain(c);
+                if (!has_best || betterFinal(c, best)) {
+                    best = c;
+                    has_best = true;
+                }
+                continue;
+            }
+            if ((int)next.size() >= width)
+                continue;
+            auto it = transpositions.find(c.hash);
+            if (it != transpositions.end() && it->second >= c.score)
+                continue;
+            transpositions[c.hash] = c.score;
+            commitTrail(c);
+            next.push_back(std::move(c));
+        }
+        beam.swap(next);
+        level++;
+
+        // Nada puede superar la cota LP
+        if (has_best && target >= 0 && best.stocks[target] >= stop_stock) {
+            if (verbose)
+                std::cout << "Cota LP alcanzada en el nivel " << level << "\n";
+            break;
+        }
+    }
+    stopPool();
+
+    if (verbose)
+        std::cout << "Beam search completado: " << level << " niveles, "
+                  << expanded << " estados expandidos\n";
+
+    if (!has_best)
+        return Solution();
+    return buildSolution(best);
+}
+
+// ============================================================================
+// EXPANSIÓN PARALELA CON ROBO DE TRABAJO
+// ============================================================================
+
+void BeamSearch::startPool()
+{
+    queues = std::vector<WorkQueue>(num_threads);
+    worker_children.assign(num_threads, std::vector<State>());
+    shutting_down = false;
+    for (int w = 1; w < num_threads; w++)
+        pool.emplace_back(&BeamSearch::workerMain, this, w);
+}
+
+void BeamSearch::stopPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        shutting_down = true;
+    }
+    pool_cv.notify_all();
+    for (auto& th : pool)
+        th.join();
+    pool.clear();
+}
+
+void BeamSearch::workerMain(int worker)
+{
+    int seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            pool_cv.wait(lock, [&] { return shutting_down || generation != seen; });
+            if (shutting_down)
+                return;
+            seen = generation;
+        }
+        runTasks(worker);
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if (--busy_workers == 0)
+                done_cv.notify_one();
+        }
+    }
+}
+
+// Cola propia por detrás; si está vacía, robar por delante de las demás
+bool BeamSearch::takeTask(int worker, int& task)
+{
+    {
+        WorkQueue& own = queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (int i = 1; i < num_threads; i++) {
+        WorkQueue& victim = queues[(worker + i) % num_threads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void BeamSearch::runTasks(int worker)
+{
+    int task;
+    while (!level_cut && takeTask(worker, task)) {
+        if (pastDeadline() || !expandState(beam[task], task, worker_children[worker]))
+            level_cut = true;
+    }
+}
+
+void BeamSearch::expandLevel()
+{
+    int n = beam.size();
+    // Con pocos estados no compensa despertar a nadie
+    int workers = n >= 2 * num_threads ? num_threads : 1;
+
+    level_cut = false;
+    for (int w = 0; w < num_threads; w++) {
+        worker_children[w].clear();
+        queues[w].tasks.clear();
+    }
+    for (int w = 0; w < workers; w++)
+        for (int i = (long long)n * w / workers; i < (long long)n * (w + 1) / workers; i++)
+            queues[w].tasks.push_back(i);
+
+    if (workers == 1) {
+        runTasks(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        busy_workers = num_threads - 1;
+        generation++;
+    }
+    pool_cv.notify_all();
+    runTasks(0);
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    done_cv.wait(lock, [&] { return busy_workers == 0; });
+}
@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_main.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 18:04:12 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 18:04:12 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/generator.hpp"
+#include "../include/mapped_parser.hpp"
+#include "../include/simulator.hpp"
+#include "../include/profiler.hpp"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+// ============================================================================
+// BENCHMARKS DE RENDIMIENTO
+// ============================================================================
+//
+// Genera cada familia a varios tamaños y mide:
+//   - Simulator::simulate: eventos simulados por segundo (lanzamientos de lote
+//     + finalizaciones) e instancias lanzadas por segundo
+//   - GraspOptimizer::solve: iteraciones por segundo (1 hilo, semilla fija)
+// Cada medida se repite hasta gastar un mínimo de tiempo para que los casos
+// pequeños no queden en ruido. El resultado va a JSON para comparar ejecuciones.
+
+typedef std::chrono::steady_clock Clock;
+
+static double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct BenchCase {
+    InstanceFamily family;
+    int size;
+    int width;
+    int grasp_iterations;
+};
+
+static void benchCase(std::ostream& json, const BenchCase& c, double min_seconds)
+{
+    InstanceParams params;
+    params.family = c.family;
+    params.size = c.size;
+    params.width = c.width;
+    params.stock = c.family == MULTIPLICITY ? 1000000 : 1000;
+    std::string text = InstanceGenerator(params).generate();
+
+    auto parse_start = Clock::now();
+    Problem problem;
+    MappedParser(problem).parseBuffer(text);
+    double parse_seconds = secondsSince(parse_start);
+
+    // Simulador: se repite entero hasta min_seconds
+    long long events = 0, instances = 0;
+    int runs = 0, final_time = 0;
+    auto sim_start = Clock::now();
+    do {
+        Simulator sim(problem);
+        sim.setRecordHistory(false);
+        sim.simulate();
+        events += sim.getEventCount();
+        instances += sim.getInstanceCount();
+        final_time = sim.getCurrentTime();
+        runs++;
+    } while (secondsSince(sim_start) < min_seconds);
+    double sim_seconds = secondsSince(sim_start);
+
+    // GRASP
+    int iterations = 0, makespan = 0;
+    auto grasp_start = Clock::now();
+    do {
+        GraspOptimizer grasp(problem);
+        grasp.setSeed(42);
+        grasp.setThreads(1);
+        grasp.setVerbose(false);
+        makespan = grasp.solve(c.grasp_iterations, 0.3).makespan;
+        iterations += c.grasp_iterations;
+    } while (secondsSince(grasp_start) < min_seconds);
+    double grasp_seconds = secondsSince(grasp_start);
+
+    json << "    {\"family\": \"" << InstanceGenerator::familyName(c.family) << "\""
+         << ", \"size\": " << c.size << ", \"width\": " << c.width
+         << ", \"resources\": " << problem.numResources()
+         << ", \"processes\": " << problem.numProcesses()
+         << ", \"parse_seconds\": " << parse_seconds << ",\n"
+         << "     \"simulator\": {\"runs\": " << runs
+         << ", \"seconds\": " << sim_seconds
+         << ", \"events\": " << events
+         << ", \"events_per_sec\": " << (events / sim_seconds)
+         << ", \"instances_per_sec\": " << (instances / sim_seconds)
+         << ", \"final_time\": " << final_time << "},\n"
+         << "     \"grasp\": {\"iterations\": " << iterations
+         << ", \"seconds\": " << grasp_seconds
+         << ", \"iterations_per_sec\": " << (iterations / grasp_seconds)
+         << ", \"makespan\": " << makespan << "}}";
+}
+
+int main(int argc, char **argv)
+{
+    std::string out_path;
+    bool quick = false;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--quick")
+            quick = true;
+        else if (arg == "--profile" && i + 1 < argc)
+            Profiler::dumpAtExit(argv[++i]);
+        else if (out_path.empty())
+            out_path = arg;
+        else
+        {
+            std::cout << "Usage: ./krpsim_bench [out.json] [--quick] [--profile json]\n";
+            return 1;
+        }
+    }
+
+    static const BenchCase cases[] = {
+        {CHAIN, 10, 1, 50},
+        {CHAIN, 100, 1, 10},
+        {CHAIN, 1000, 1, 2},
+        {FANOUT_DAG, 5, 8, 50},
+        {FANOUT_DAG, 20, 32, 5},
+        {CYCLIC, 4, 1, 20},
+        {CYCLIC, 64, 1, 5},
+        {MULTIPLICITY, 4, 4, 20},
+        {MULTIPLICITY, 16, 16, 5},
+    };
+    double min_seconds = quick ? 0.02 : 0.5;
+
+    std::ostringstream json;
+    json.precision(6);
+    json << "{\n  \"version\": 1,\n  \"min_seconds\": " << min_seconds
+         << ",\n  \"benchmarks\": [\n";
+    bool first = true;
+    for (const BenchCase& c : cases)
+    {
+        if (!first)
+            json << ",\n";
+        first = false;
+        std::cerr << "bench " << InstanceGenerator::familyName(c.family)
+                  << " size=" << c.size << "\n";
+        benchCase(json, c, min_seconds);
+    }
+    json << "\n  ]\n}\n";
+
+    if (out_path.empty())
+    {
+        std::cout << json.str();
+        return 0;
+    }
+    std::ofstream file(out_path);
+    if (!(file << json.str()))
+    {
+        std::cerr << "No se puede escribir " << out_path << "\n";
+        return 1;
+    }
+    std::cerr << "Resultados en " << out_path << "\n";
+    return 0;
+}
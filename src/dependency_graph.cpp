@@ -0,0 +1,481 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dependency_graph.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 12:05:37 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 12:05:37 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/dependency_graph.hpp"
+
+// Tope para las necesidades propagadas (evita desbordes en cadenas largas)
+static const long NEED_CAP = 1L << 50;
+
+DependencyGraph::DependencyGraph()
+    : num_resources(0), num_processes(0), target(-1), critical_length(0)
+{
+}
+
+void DependencyGraph::analyze_full_chain(int target_res, int target_quantity,
+                                         const std::vector<int>& stocks,
+                                         const Problem& problem)
+{
+    num_resources = problem.numResources();
+    num_processes = problem.numProcesses();
+    target = target_res;
+
+    condense(problem);
+    compute_time_to_produce(stocks, problem);
+    compute_critical_path(problem);
+    compute_needs(target_quantity, stocks, problem);
+    compute_priorities(problem);
+}
+
+// ============================================================================
+// CONDENSACIÓN EN SCCs (Tarjan iterativo)
+// ============================================================================
+
+void DependencyGraph::condense(const Problem& problem)
+{
+    const int R = num_resources;
+    const int n = num_resources + num_processes;
+
+    // Sucesores de un nodo: consumidores si es recurso, productos si es proceso
+    auto succ_begin = [&](int node) {
+        return node < R ? problem.consumer_offsets[node]
+                        : problem.prod_offsets[node - R];
+    };
+    auto succ_end = [&](int node) {
+        return node < R ? problem.consumer_offsets[node + 1]
+                        : problem.prod_offsets[node - R + 1];
+    };
+    auto succ_at = [&](int node, int k) {
+        return node < R ? R + problem.consumer_procs[k]
+                        : problem.prod_resources[k];
+    };
+
+    comp_of.assign(n, -1);
+    std::vector<int> index(n, -1);
+    std::vector<int> low(n, 0);
+    std::vector<char> on_stack(n, 0);
+    std::vector<int> stack;
+    std::vector<std::pair<int, int> > call;  // (nodo, siguiente arista)
+    int counter = 0;
+    int num_comps = 0;
+
+    for (int root = 0; root < n; root++) {
+        if (index[root] >= 0)
+            continue;
+        index[root] = low[root] = counter++;
+        stack.push_back(root);
+        on_stack[root] = 1;
+        call.push_back({root, succ_begin(root)});
+
+        while (!call.empty()) {
+            int node = call.back().first;
+            int k = call.back().second;
+
+            if (k < succ_end(node)) {
+                call.back().second++;
+                int next = succ_at(node, k);
+                if (index[next] < 0) {
+                    index[next] = low[next] = counter++;
+                    stack.push_back(next);
+                    on_stack[next] = 1;
+                    call.push_back({next, succ_begin(next)});
+                } else if (on_stack[next]) {
+                    low[node] = std::min(low[node], index[next]);
+                }
+                continue;
+            }
+
+            call.pop_back();
+            if (!call.empty()) {
+                int parent = call.back().first;
+                low[parent] = std::min(low[parent], low[node]);
+            }
+            if (low[node] == index[node]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = 0;
+                    comp_of[w] = num_comps;
+                } while (w != node);
+                num_comps++;
+            }
+        }
+    }
+
+    // Tarjan emite los SCCs con los sucesores antes: id(sucesor) < id(comp)
+    comp_weight.assign(num_comps, 0);
+    for (int p = 0; p < num_processes; p++) {
+        int c = comp_of[R + p];
+        comp_weight[c] = std::max(comp_weight[c], problem.delays[p]);
+    }
+
+    // Agrupar nodos por componente para construir el DAG en CSR sin duplicados
+    std::vector<int> node_offsets(num_comps + 1, 0);
+    for (int node = 0; node < n; node++)
+        node_offsets[comp_of[node] + 1]++;
+    for (int c = 0; c < num_comps; c++)
+        node_offsets[c + 1] += node_offsets[c];
+    std::vector<int> nodes(n);
+    std::vector<int> fill(node_offsets.begin(), node_offsets.end() - 1);
+    for (int node = 0; node < n; node++)
+        nodes[fill[comp_of[node]]++] = node;
+
+    std::vector<int> seen(num_comps, -1);
+    comp_succ_offsets.assign(1, 0);
+    comp_succ.clear();
+    for (int c = 0; c < num_comps; c++) {
+        for (int i = node_offsets[c]; i < node_offsets[c + 1]; i++) {
+            int node = nodes[i];
+            for (int k = succ_begin(node); k < succ_end(node); k++) {
+                int d = comp_of[succ_at(node, k)];
+                if (d != c && seen[d] != c) {
+                    seen[d] = c;
+                    comp_succ.push_back(d);
+                }
+            }
+        }
+        comp_succ_offsets.push_back(comp_succ.size());
+    }
+}
+
+// ============================================================================
+// TIEMPO DE PRODUCCIÓN (Dijkstra AND/OR de Knuth)
+// ============================================================================
+//
+// Un recurso está disponible en cuanto termina su productor más temprano;
+// un proceso puede empezar cuando están disponibles TODOS sus requisitos.
+// Los recursos se fijan en orden creciente de tiempo, así que los ciclos
+// no necesitan iterar.
+
+void DependencyGraph::compute_time_to_produce(const std::vector<int>& stocks,
+                                              const Problem& problem)
+{
+    typedef std::pair<int, int> Entry;  // (tiempo, recurso)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+
+    time_to_produce.assign(num_resources, INF);
+    std::vector<int> missing(num_processes);
+    std::vector<int>& earliest_start = process_start;
+    earliest_start.assign(num_processes, 0);
+    std::vector<char> done(num_resources, 0);
+
+    auto relax_products = [&](int p) {
+        int finish = earliest_start[p] + problem.delays[p];
+        for (int k = problem.prod_offsets[p]; k < problem.prod_offsets[p + 1]; k++) {
+            int s = problem.prod_resources[k];
+            if (finish < time_to_produce[s]) {
+                time_to_produce[s] = finish;
+                queue.push({finish, s});
+            }
+        }
+    };
+
+    for (int r = 0; r < num_resources; r++) {
+        if (stocks[r] > 0) {
+            time_to_produce[r] = 0;
+            queue.push({0, r});
+        }
+    }
+    for (int p = 0; p < num_processes; p++) {
+        missing[p] = problem.req_offsets[p + 1] - problem.req_offsets[p];
+        if (missing[p] == 0)
+            relax_products(p);
+    }
+
+    while (!queue.empty()) {
+        auto [t, r] = queue.top();
+        queue.pop();
+        if (done[r] || t != time_to_produce[r])
+            continue;
+        done[r] = 1;
+        for (int k = problem.consumer_offsets[r]; k < problem.consumer_offsets[r + 1]; k++) {
+            int p = problem.consumer_procs[k];
+            earliest_start[p] = std::max(earliest_start[p], t);
+            if (--missing[p] == 0)
+                relax_products(p);
+        }
+    }
+
+    // Procesos que nunca llegan a tener todos sus requisitos
+    for (int p = 0; p < num_processes; p++)
+        if (missing[p] > 0)
+            earliest_start[p] = INF;
+}
+
+// ============================================================================
+// CAMINO CRÍTICO Y HOLGURAS
+// ============================================================================
+//
+// Grafo Y/O: la cabeza de un proceso es su inicio más temprano (todos sus
+// requisitos) y la cola sale de un Dijkstra inverso desde el objetivo (el
+// mejor de sus productos). El DAG de SCCs solo marca qué componentes llevan
+// al objetivo
+
+void DependencyGraph::compute_critical_path(const Problem& problem)
+{
+    int num_comps = comp_weight.size();
+    comp_relevant.assign(num_comps, 0);
+    node_tail.assign(num_resources + num_processes, INF);
+    critical_length = 0;
+    if (target < 0)
+        return;
+
+    int target_comp = comp_of[target];
+
+    // Hacia atrás (sumideros primero): qué SCCs llevan al objetivo
+    for (int c = 0; c < num_comps; c++) {
+        bool relevant = c == target_comp;
+        for (int k = comp_succ_offsets[c]; !relevant && k < comp_succ_offsets[c + 1]; k++)
+            relevant = comp_relevant[comp_succ[k]];
+        comp_relevant[c] = relevant;
+    }
+
+    // Tiempo mínimo hasta el objetivo: Dijkstra inverso. Un proceso tarda su
+    // delay más lo que falta desde el mejor de sus productos; un recurso
+    // puede seguir por cualquiera de sus consumidores
+    typedef std::pair<int, int> Entry;  // (tiempo, nodo)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+    node_tail[target] = 0;
+    queue.push({0, target});
+    while (!queue.empty()) {
+        auto [t, node] = queue.top();
+        queue.pop();
+        if (t != node_tail[node])
+            continue;
+        if (node < num_resources) {
+            for (int k = problem.producer_offsets[node]; k < problem.producer_offsets[node + 1]; k++) {
+                int p = num_resources + problem.producer_procs[k];
+                int tail = t + problem.delays[p - num_resources];
+                if (tail < node_tail[p]) {
+                    node_tail[p] = tail;
+                    queue.push({tail, p});
+                }
+            }
+        } else {
+            int p = node - num_resources;
+            for (int k = problem.req_offsets[p]; k < problem.req_offsets[p + 1]; k++) {
+                int r = problem.req_resources[k];
+                if (t < node_tail[r]) {
+                    node_tail[r] = t;
+                    queue.push({t, r});
+                }
+            }
+        }
+    }
+
+    if (time_to_produce[target] < INF)
+        critical_length = time_to_produce[target];
+}
+
+void DependencyGraph::compute_needs(int target_quantity,
+                                   const std::vector<int>& stocks,
+                                   const Problem& problem)
+{
+    const int R = num_resources;
+    need.assign(num_resources, 0);
+    availability.assign(num_resources, 1.0);
+    bottleneck.assign(num_resources, 0);
+    if (target < 0)
+        return;
+
+    // Recursos relevantes de sumideros a orígenes: la necesidad de las
+    // entradas depende de la de las salidas. Dentro de un ciclo, lo que
+    // vuelve a un recurso ya procesado se descarta
+    std::vector<int> order;
+    for (int r = 0; r < num_resources; r++)
+        if (comp_relevant[comp_of[r]])
+            order.push_back(r);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return comp_of[a] != comp_of[b] ? comp_of[a] < comp_of[b] : a < b;
+    });
+
+    std::vector<char> processed(num_resources, 0);
+    need[target] = target_quantity;
+
+    for (int r : order) {
+        processed[r] = 1;
+        long deficit = need[r] - stocks[r];
+        if (deficit <= 0)
+            continue;
+
+        // Productor relevante que antes puede terminar
+        int best = -1;
+        int best_amount = 0;
+        int best_finish = INF;
+        for (int k = problem.producer_offsets[r]; k < problem.producer_offsets[r + 1]; k++) {
+            int p = problem.producer_procs[k];
+            if (!comp_relevant[comp_of[R + p]])
+                continue;
+            int start = 0;
+            for (int j = problem.req_offsets[p]; j < problem.req_offsets[p + 1]; j++)
+                start = std::max(start, time_to_produce[problem.req_resources[j]]);
+            int finish = start >= INF ? INF : start + problem.delays[p];
+            if (best < 0 || finish < best_finish) {
+                best = p;
+                best_finish = finish;
+            }
+        }
+        if (best < 0)
+            continue;
+        for (int k = problem.prod_offsets[best]; k < problem.prod_offsets[best + 1]; k++)
+            if (problem.prod_resources[k] == r)
+                best_amount = problem.prod_amounts[k];
+        if (best_amount <= 0)
+            continue;
+
+        // runs puede rondar NEED_CAP: se satura antes de multiplicar
+        long runs = (deficit + best_amount - 1) / best_amount;
+        for (int k = problem.req_offsets[best]; k < problem.req_offsets[best + 1]; k++) {
+            int s = problem.req_resources[k];
+            long amount = problem.req_amounts[k];
+            if (processed[s] || amount <= 0)
+                continue;
+            if (runs > (NEED_CAP - need[s]) / amount)
+                need[s] = NEED_CAP;
+            else
+                need[s] += runs * amount;
+        }
+    }
+
+    for (int r = 0; r < num_resources; r++) {
+        if (need[r] <= 0)
+            continue;
+        availability[r] = (double)stocks[r] / need[r];
+
+        // Cuello de botella: hay déficit y o bien no hay alternativas de
+        // producción o bien varios procesos relevantes se lo disputan
+        if (need[r] > stocks[r]) {
+            int relevant_consumers = 0;
+            for (int k = problem.consumer_offsets[r]; k < problem.consumer_offsets[r + 1]; k++)
+                if (comp_relevant[comp_of[R + problem.consumer_procs[k]]])
+                    relevant_consumers++;
+            if (problem.numProducers(r) <= 1 || relevant_consumers > 1)
+                bottleneck[r] = 1;
+        }
+    }
+}
+
+// Prioridad según la distancia (en pasos de proceso) al objetivo
+void DependencyGraph::compute_priorities(const Problem& problem)
+{
+    resource_priority.assign(num_resources, 0);
+    if (target < 0)
+        return;
+
+    std::vector<int> hops(num_resources, -1);
+    std::queue<int> queue;
+    hops[target] = 0;
+    queue.push(target);
+    while (!queue.empty()) {
+        int r = queue.front();
+        queue.pop();
+        for (int k = problem.producer_offsets[r]; k < problem.producer_offsets[r + 1]; k++) {
+            int p = problem.producer_procs[k];
+            for (int j = problem.req_offsets[p]; j < problem.req_offsets[p + 1]; j++) {
+                int s = problem.req_resources[j];
+                if (hops[s] < 0) {
+                    hops[s] = hops[r] + 1;
+                    queue.push(s);
+                }
+            }
+        }
+    }
+
+    for (int r = 0; r < num_resources; r++)
+        if (hops[r] >= 0)
+            resource_priority[r] = 1000 / (1 + hops[r]);
+}
+
+// ============================================================================
+// CONSULTAS O(1)
+// ============================================================================
+
+// Cuánto se aparta la mejor ruta que pasa por el nodo de la más rápida;
+// los nodos que no llevan al objetivo (o no pueden empezar) tienen la
+// holgura máxima
+int DependencyGraph::node_slack(int node) const
+{
+    int start = node < num_resources ? time_to_produce[node]
+                                     : process_start[node - num_resources];
+    if (node_tail[node] >= INF || start >= INF)
+        return critical_length;
+    long slack = (long)start + node_tail[node] - critical_length;
+    return (int)std::max(0L, std::min<long>(slack, critical_length));
+}
+
+bool DependencyGraph::node_is_critical(int node) const
+{
+    return critical_length > 0 && node_tail[node] < INF && node_slack(node) == 0;
+}
+
+bool DependencyGraph::is_process_critical(int p) const
+{
+    if (!is_analyzed() || target < 0)
+        return false;
+    return node_is_critical(num_resources + p);
+}
+
+int DependencyGraph::get_process_slack(int p) const
+{
+    if (!is_analyzed() || target < 0)
+        return 0;
+    return node_slack(num_resources + p);
+}
+
+int DependencyGraph::get_resource_priority(int r) const
+{
+    if (r >= (int)resource_priority.size())
+        return 0;
+    return resource_priority[r];
+}
+
+bool DependencyGraph::is_on_critical_path(int r) const
+{
+    if (!is_analyzed() || target < 0)
+        return false;
+    return node_is_critical(r);
+}
+
+int DependencyGraph::get_time_to_produce(int r) const
+{
+    if (r >= (int)time_to_produce.size())
+        return 0;
+    return time_to_produce[r];
+}
+
+int DependencyGraph::get_critical_path_length(int r) const
+{
+    if (!is_analyzed() || target < 0 || node_tail[r] >= INF)
+        return 0;
+    return node_tail[r];
+}
+
+bool DependencyGraph::is_bottleneck(int r) const
+{
+    if (r >= (int)bottleneck.size())
+        return false;
+    return bottleneck[r];
+}
+
+double DependencyGraph::get_availability_ratio(int r) const
+{
+    if (r >= (int)availability.size())
+        return 1.0;
+    return availability[r];
+}
+
+long DependencyGraph::get_need(int r) const
+{
+    if (r >= (int)need.size())
+        return 0;
+    return need[r];
+}
@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   gen_main.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 18:04:12 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 18:04:12 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/generator.hpp"
+
+static int usage()
+{
+    std::cout << "Usage: ./krpsim_gen chain|dag|cycle|multiplicity size"
+                 " [--width n] [--fan n] [--stock n] [--seed n]\n";
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+        return usage();
+
+    InstanceParams params;
+    if (!InstanceGenerator::parseFamily(argv[1], params.family))
+        return usage();
+    params.size = std::atoi(argv[2]);
+
+    for (int i = 3; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+            return usage();
+        if (arg == "--width")
+            params.width = std::atoi(argv[++i]);
+        else if (arg == "--fan")
+            params.fan = std::atoi(argv[++i]);
+        else if (arg == "--stock")
+            params.stock = std::atoi(argv[++i]);
+        else if (arg == "--seed")
+            params.seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+            return usage();
+    }
+
+    std::cout << InstanceGenerator(params).generate();
+    return 0;
+}
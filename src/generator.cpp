@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   generator.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 18:04:12 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 18:04:12 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/generator.hpp"
+
+InstanceGenerator::InstanceGenerator(const InstanceParams& params)
+    : params(params), rng(params.seed)
+{
+}
+
+bool InstanceGenerator::parseFamily(const std::string& name, InstanceFamily& family)
+{
+    static const InstanceFamily all[] = {CHAIN, FANOUT_DAG, CYCLIC, MULTIPLICITY};
+    for (InstanceFamily f : all)
+        if (name == familyName(f)) {
+            family = f;
+            return true;
+        }
+    return false;
+}
+
+const char* InstanceGenerator::familyName(InstanceFamily family)
+{
+    switch (family) {
+        case CHAIN:        return "chain";
+        case FANOUT_DAG:   return "dag";
+        case CYCLIC:       return "cycle";
+        case MULTIPLICITY: return "multiplicity";
+    }
+    return "?";
+}
+
+std::string InstanceGenerator::generate()
+{
+    out.clear();
+    rng = Rng(params.seed);
+    out += "# ";
+    out += familyName(params.family);
+    out += " size=" + std::to_string(params.size)
+         + " width=" + std::to_string(params.width)
+         + " fan=" + std::to_string(params.fan)
+         + " stock=" + std::to_string(params.stock)
+         + " seed=" + std::to_string(params.seed) + "\n";
+
+    switch (params.family) {
+        case CHAIN:        chain(); break;
+        case FANOUT_DAG:   dag(); break;
+        case CYCLIC:       cyclic(); break;
+        case MULTIPLICITY: multiplicity(); break;
+    }
+    return out;
+}
+
+// ============================================================================
+// FAMILIAS
+// ============================================================================
+
+void InstanceGenerator::chain()
+{
+    int n = std::max(1, params.size);
+    stockLine("r0", params.stock);
+    for (int i = 0; i < n; i++) {
+        std::string from = "r" + std::to_string(i);
+        std::string to = "r" + std::to_string(i + 1);
+        processLine("step" + std::to_string(i), {{from, 1}}, {{to, 1}},
+                    1 + rng.below(5));
+    }
+    optimizeLine("r" + std::to_string(n));
+}
+
+static std::string layerResource(int layer, int i)
+{
+    return "l" + std::to_string(layer) + "_" + std::to_string(i);
+}
+
+void InstanceGenerator::dag()
+{
+    int layers = std::max(1, params.size);
+    int width = std::max(1, params.width);
+    int fan = std::max(1, std::min(params.fan, width));
+
+    for (int i = 0; i < width; i++)
+        stockLine(layerResource(0, i), params.stock);
+
+    std::vector<int> picks(width);
+    for (int l = 1; l <= layers; l++) {
+        for (int i = 0; i < width; i++) {
+            // fan entradas distintas de la capa anterior (Fisher-Yates parcial)
+            for (int k = 0; k < width; k++)
+                picks[k] = k;
+            std::vector<std::pair<std::string, int> > needs;
+            for (int k = 0; k < fan; k++) {
+                int j = k + rng.below(width - k);
+                std::swap(picks[k], picks[j]);
+                needs.push_back({layerResource(l - 1, picks[k]), 1 + rng.below(3)});
+            }
+            processLine("make_" + layerResource(l, i), needs,
+                        {{layerResource(l, i), 1 + rng.below(2)}}, 1 + rng.below(10));
+        }
+    }
+    optimizeLine(layerResource(layers, 0));
+}
+
+void InstanceGenerator::cyclic()
+{
+    int n = std::max(2, params.size);
+    stockLine("c0", params.stock);
+    for (int i = 0; i < n; i++) {
+        std::string from = "c" + std::to_string(i);
+        std::string to = "c" + std::to_string((i + 1) % n);
+        processLine("turn" + std::to_string(i), {{from, 2}}, {{to, 2}, {"gold", 1}},
+                    1 + rng.below(4));
+    }
+    processLine("sell", {{"gold", 10}}, {{"score", 1}}, 5);
+    optimizeLine("score");
+}
+
+void InstanceGenerator::multiplicity()
+{
+    int stages = std::max(1, params.size);
+    int width = std::max(1, params.width);
+    stockLine("raw", params.stock);
+    for (int s = 0; s < stages; s++) {
+        std::string from = s == 0 ? "raw" : "stage" + std::to_string(s - 1);
+        std::string to = "stage" + std::to_string(s);
+        for (int i = 0; i < width; i++) {
+            int in = 1 + rng.below(3);
+            processLine("bulk" + std::to_string(s) + "_" + std::to_string(i),
+                        {{from, in}}, {{to, in}}, 1 + rng.below(20));
+        }
+    }
+    optimizeLine("stage" + std::to_string(stages - 1));
+}
+
+// ============================================================================
+// SALIDA
+// ============================================================================
+
+void InstanceGenerator::stockLine(const std::string& name, int qty)
+{
+    out += name + ":" + std::to_string(qty) + "\n";
+}
+
+static void appendItems(std::string& out, const std::vector<std::pair<std::string, int> >& items)
+{
+    out += "(";
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i > 0)
+            out += ";";
+        out += items[i].first + ":" + std::to_string(items[i].second);
+    }
+    out += ")";
+}
+
+void InstanceGenerator::processLine(const std::string& name,
+                                    const std::vector<std::pair<std::string, int> >& needs,
+                                    const std::vector<std::pair<std::string, int> >& results,
+                                    int delay)
+{
+    out += name + ":";
+    appendItems(out, needs);
+    out += ":";
+    appendItems(out, results);
+    out += ":" + std::to_string(delay) + "\n";
+}
+
+void InstanceGenerator::optimizeLine(const std::string& target)
+{
+    out += "optimize:(time;" + target + ")\n";
+}
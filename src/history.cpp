@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   history.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:01:19 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 15:01:19 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/history.hpp"
+
+History::History() : num_resources(0), open_begin(0)
+{
+}
+
+void History::reset(const std::vector<int>& initial_stocks)
+{
+    num_resources = initial_stocks.size();
+    entries.clear();
+    entry_frame.clear();
+    frames.clear();
+    delta_resources.clear();
+    delta_amounts.clear();
+    checkpoints = initial_stocks;
+    current = initial_stocks;
+    pending_pos.assign(num_resources, -1);
+    open_begin = 0;
+}
+
+void History::closeFrame(int time)
+{
+    for (size_t k = open_begin; k < delta_resources.size(); k++)
+        pending_pos[delta_resources[k]] = -1;
+
+    frames.push_back(Frame{time, open_begin});
+    open_begin = delta_resources.size();
+
+    if (frames.size() % CHECKPOINT_EVERY == 0)
+        checkpoints.insert(checkpoints.end(), current.begin(), current.end());
+}
+
+void History::seal(int time)
+{
+    if ((size_t)open_begin == delta_resources.size())
+        return;
+    closeFrame(time);
+}
+
+void History::record(const execution& e, int time)
+{
+    closeFrame(time);
+    entries.push_back(e);
+    entry_frame.push_back(frames.size() - 1);
+}
+
+void History::advance(std::vector<int>& out, int& from_frame, int f) const
+{
+    // Sin estado válido o demasiado lejos: empezar desde el checkpoint
+    int checkpoint = (f + 1) / CHECKPOINT_EVERY;
+    int checkpoint_frame = checkpoint * CHECKPOINT_EVERY - 1;
+    if (from_frame < -1 || from_frame > f || from_frame < checkpoint_frame) {
+        auto first = checkpoints.begin() + (size_t)checkpoint * num_resources;
+        out.assign(first, first + num_resources);
+        from_frame = checkpoint_frame;
+    }
+
+    for (int fr = from_frame + 1; fr <= f; fr++) {
+        int end = fr + 1 < (int)frames.size() ? frames[fr + 1].delta_begin : open_begin;
+        for (int k = frames[fr].delta_begin; k < end; k++)
+            out[delta_resources[k]] += delta_amounts[k];
+    }
+    from_frame = f;
+}
+
+std::vector<int> History::snapshot(size_t i) const
+{
+    std::vector<int> out;
+    int from = -2;
+    advance(out, from, entry_frame[i]);
+    return out;
+}
+
+// Stocks al final del ciclo dado (después de los lanzamientos de ese ciclo)
+std::vector<int> History::stocksAt(int cycle) const
+{
+    auto it = std::upper_bound(frames.begin(), frames.end(), cycle,
+        [](int t, const Frame& f) { return t < f.time; });
+    int f = (int)(it - frames.begin()) - 1;
+
+    std::vector<int> out;
+    int from = -2;
+    advance(out, from, f);
+    return out;
+}
+
+const std::vector<int>& History::const_iterator::snapshot() const
+{
+    history->advance(state, state_frame, history->entry_frame[index]);
+    return state;
+}
+
+size_t History::memoryUsage() const
+{
+    return entries.capacity() * sizeof(execution)
+         + entry_frame.capacity() * sizeof(int)
+         + frames.capacity() * sizeof(Frame)
+         + (delta_resources.capacity() + delta_amounts.capacity()) * sizeof(int)
+         + checkpoints.capacity() * sizeof(int);
+}
@@ -0,0 +1,280 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lp_bound.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 19:40:12 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 19:40:12 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/lp_bound.hpp"
+#include "../include/dependency_graph.hpp"
+#include "../include/objective.hpp"
+#include <cmath>
+
+// Pivotes degenerados seguidos antes de pasar a la regla de Bland
+static const int DEGENERATE_LIMIT = 64;
+
+// ============================================================================
+// SIMPLEX
+// ============================================================================
+
+SimplexLP::SimplexLP(int num_vars)
+    : num_vars(num_vars), objective(num_vars, 0.0), stride(0)
+{
+}
+
+int SimplexLP::addConstraint(const std::vector<std::pair<int, double> >& coefs, double rhs)
+{
+    rows.push_back(Row{coefs, std::max(0.0, rhs)});
+    return rows.size() - 1;
+}
+
+void SimplexLP::pivot(int row, int col)
+{
+    const int m = rows.size();
+    double inv = 1.0 / at(row, col);
+    for (int j = 0; j < stride; j++)
+        at(row, j) *= inv;
+    for (int i = 0; i <= m; i++) {
+        if (i == row)
+            continue;
+        double factor = at(i, col);
+        if (std::fabs(factor) < EPS)
+            continue;
+        double* dst = &tableau[(size_t)i * stride];
+        const double* src = &tableau[(size_t)row * stride];
+        for (int j = 0; j < stride; j++)
+            dst[j] -= factor * src[j];
+        dst[col] = 0.0;
+    }
+    basis[row] = col;
+}
+
+SimplexLP::Status SimplexLP::solve(int max_pivots)
+{
+    const int m = rows.size();
+    const int n = num_vars;
+    stride = n + m + 1;
+    tableau.assign((size_t)(m + 1) * stride, 0.0);
+    basis.resize(m);
+
+    for (int i = 0; i < m; i++) {
+        for (const auto& c : rows[i].coefs)
+            at(i, c.first) += c.second;
+        at(i, n + i) = 1.0;
+        at(i, stride - 1) = rows[i].rhs;
+        basis[i] = n + i;
+    }
+    for (int j = 0; j < n; j++)
+        at(m, j) = -objective[j];
+
+    bool bland = false;
+    int degenerate = 0;
+    for (int it = 0; it < max_pivots; it++) {
+        // Columna entrante: coste reducido más negativo (o el primero)
+        int col = -1;
+        double best = -EPS;
+        for (int j = 0; j < n + m; j++) {
+            if (at(m, j) < best) {
+                col = j;
+                if (bland)
+                    break;
+                best = at(m, j);
+            }
+        }
+        if (col < 0)
+            return OPTIMAL;
+
+        // Fila saliente: menor cociente; empates por menor índice básico
+        int row = -1;
+        double ratio = 0;
+        for (int i = 0; i < m; i++) {
+            double a = at(i, col);
+            if (a <= EPS)
+                continue;
+            double r = at(i, stride - 1) / a;
+            if (row < 0 || r < ratio - EPS ||
+                (r <= ratio + EPS && basis[i] < basis[row])) {
+                row = i;
+                ratio = r;
+            }
+        }
+        if (row < 0)
+            return UNBOUNDED;
+
+        if (ratio <= EPS && ++degenerate > DEGENERATE_LIMIT)
+            bland = true;
+        else if (ratio > EPS)
+            degenerate = 0;
+        pivot(row, col);
+    }
+    return ITERATION_LIMIT;
+}
+
+double SimplexLP::value() const
+{
+    return at(rows.size(), stride - 1);
+}
+
+double SimplexLP::primal(int var) const
+{
+    for (size_t i = 0; i < rows.size(); i++)
+        if (basis[i] == var)
+            return at(i, stride - 1);
+    return 0.0;
+}
+
+double SimplexLP::dual(int row) const
+{
+    return at(rows.size(), num_vars + row);
+}
+
+double SimplexLP::slack(int row) const
+{
+    for (size_t i = 0; i < rows.size(); i++)
+        if (basis[i] == num_vars + row)
+            return at(i, stride - 1);
+    return 0.0;
+}
+
+// ============================================================================
+// COTA DE PRODUCCIÓN
+// ============================================================================
+
+int ThroughputResult::stockBound() const
+{
+    if (status != BOUNDED)
+        return std::numeric_limits<int>::max();
+    double v = std::floor(max_stock + 1e-6);
+    return v >= (double)std::numeric_limits<int>::max()
+        ? std::numeric_limits<int>::max() : (int)v;
+}
+
+double ThroughputResult::gap(int achieved) const
+{
+    int bound = stockBound();
+    if (status != BOUNDED || bound <= 0)
+        return 0.0;
+    return std::max(0.0, (double)(bound - achieved) / bound);
+}
+
+ThroughputBound::ThroughputBound(const Problem& problem, int horizon)
+    : problem(problem), horizon(horizon)
+{
+}
+
+ThroughputResult ThroughputBound::compute(int target) const
+{
+    const int R = problem.numResources();
+    const int P = problem.numProcesses();
+    ThroughputResult result;
+    result.horizon = horizon;
+    result.shadow_prices.assign(R, 0.0);
+    result.runs.assign(P, 0.0);
+    if (target < 0 || target >= R)
+        return result;
+
+    // Solo cuentan los procesos aguas arriba del objetivo: los demás solo
+    // pueden quitarle recursos, así que fijarlos a 0 no baja la cota
+    std::vector<char> upstream = Objective::upstreamOf(problem, std::vector<int>(1, target));
+
+    // Y que puedan terminar dentro del horizonte -> variables
+    DependencyGraph graph;
+    graph.analyze_full_chain(target, 1, problem.initial_stocks, problem);
+    std::vector<int> var_of(P, -1);
+    std::vector<int> proc_of;
+    for (int p = 0; p < P; p++) {
+        if (!upstream[p])
+            continue;
+        long long start = 0;
+        for (int k = problem.req_offsets[p]; k < problem.req_offsets[p + 1]; k++)
+            start = std::max<long long>(start, graph.get_time_to_produce(problem.req_resources[k]));
+        if (start + problem.delays[p] > horizon)
+            continue;
+        var_of[p] = proc_of.size();
+        proc_of.push_back(p);
+    }
+
+    // Una fila por recurso que consume alguna variable
+    std::vector<int> resource_rows;
+    for (int r = 0; r < R; r++)
+        for (int k = problem.consumer_offsets[r]; k < problem.consumer_offsets[r + 1]; k++)
+            if (var_of[problem.consumer_procs[k]] >= 0) {
+                resource_rows.push_back(r);
+                break;
+            }
+    if (SimplexLP::tableauCells(proc_of.size(), resource_rows.size()) > MAX_CELLS)
+        return result;
+
+    SimplexLP lp(proc_of.size());
+    std::vector<std::pair<int, double> > coefs;
+    for (int r : resource_rows) {
+        coefs.clear();
+        for (int k = problem.consumer_offsets[r]; k < problem.consumer_offsets[r + 1]; k++) {
+            int p = problem.consumer_procs[k];
+            if (var_of[p] >= 0)
+                coefs.push_back({var_of[p], 0.0});
+        }
+        for (int k = problem.producer_offsets[r]; k < problem.producer_offsets[r + 1]; k++) {
+            int p = problem.producer_procs[k];
+            if (var_of[p] >= 0)
+                coefs.push_back({var_of[p], 0.0});
+        }
+        // Coeficiente neto (consumo - producción) de cada variable
+        for (auto& c : coefs) {
+            int p = proc_of[c.first];
+            double v = 0;
+            for (int k = problem.req_offsets[p]; k < problem.req_offsets[p + 1]; k++)
+                if (problem.req_resources[k] == r)
+                    v += problem.req_amounts[k];
+            for (int k = problem.prod_offsets[p]; k < problem.prod_offsets[p + 1]; k++)
+                if (problem.prod_resources[k] == r)
+                    v -= problem.prod_amounts[k];
+            c.second = v;
+        }
+        std::sort(coefs.begin(), coefs.end());
+        coefs.erase(std::unique(coefs.begin(), coefs.end()), coefs.end());
+        lp.addConstraint(coefs, problem.initial_stocks[r]);
+    }
+
+    // Objetivo: ganancia neta del recurso objetivo
+    for (size_t v = 0; v < proc_of.size(); v++) {
+        int p = proc_of[v];
+        double gain = 0;
+        for (int k = problem.prod_offsets[p]; k < problem.prod_offsets[p + 1]; k++)
+            if (problem.prod_resources[k] == target)
+                gain += problem.prod_amounts[k];
+        for (int k = problem.req_offsets[p]; k < problem.req_offsets[p + 1]; k++)
+            if (problem.req_resources[k] == target)
+                gain -= problem.req_amounts[k];
+        lp.setObjective(v, gain);
+    }
+
+    int max_pivots = 50 * (int)(proc_of.size() + resource_rows.size()) + 1000;
+    SimplexLP::Status status = lp.solve(max_pivots);
+    if (status == SimplexLP::UNBOUNDED) {
+        result.status = ThroughputResult::UNBOUNDED;
+        return result;
+    }
+    if (status != SimplexLP::OPTIMAL)
+        return result;
+
+    result.status = ThroughputResult::BOUNDED;
+    result.max_stock = problem.initial_stocks[target] + lp.value();
+    result.rate = horizon > 0 ? lp.value() / horizon : 0.0;
+    for (size_t v = 0; v < proc_of.size(); v++)
+        result.runs[proc_of[v]] = lp.primal(v);
+    for (size_t i = 0; i < resource_rows.size(); i++) {
+        double price = lp.dual(i);
+        result.shadow_prices[resource_rows[i]] = price;
+        if (price > SimplexLP::EPS && lp.slack(i) <= 1e-6)
+            result.binding.push_back(resource_rows[i]);
+    }
+    std::stable_sort(result.binding.begin(), result.binding.end(),
+        [&](int a, int b) { return result.shadow_prices[a] > result.shadow_prices[b]; });
+    return result;
+}
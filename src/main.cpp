@@ -11,32 +11,277 @@
 /* ************************************************************************** */
 
 #include "../include/simulator.hpp"
+#include "../include/mapped_parser.hpp"
+#include "../include/mapped_file.hpp"
+#include "../include/problem_cache.hpp"
+#include "../include/profiler.hpp"
+#include "../include/beam_search.hpp"
+#include "../include/lp_bound.hpp"
+
+static int usage()
+{
+    std::cout << "Usage: ./krpsim \"file\" [delay] [--trace \"out\"] [--cache \"bin\"] [--profile \"json\"]\n"
+              << "                [--engine sim|grasp|beam] [--beam-width n]\n"
+              << "       ./krpsim \"file\" --compile \"bin\"\n";
+    return 1;
+}
+
+// Carga el problema: una caché binaria se usa tal cual; un fichero de texto
+// se parsea, salvo que cache_path tenga una caché generada con su mismo
+// contenido. Si la caché falta o está obsoleta se regenera.
+static bool loadProblem(const std::string &file, const std::string &cache_path,
+                        Problem &problem, uint64_t &source_hash)
+{
+    source_hash = 0;
+    if (ProblemCache::isCache(file))
+        return ProblemCache::load(file, problem);
+
+    MappedFile source;
+    if (!source.open(file))
+        return false;
+    source_hash = ProblemCache::hashSource(source.view());
+
+    if (!cache_path.empty() && ProblemCache::load(cache_path, problem, source_hash))
+        return true;
+
+    MappedParser parser(problem);
+    parser.parseBuffer(source.view());
+    if (!cache_path.empty() && !ProblemCache::write(cache_path, problem, source_hash))
+        std::cerr << "No se puede escribir la caché " << cache_path << "\n";
+    return true;
+}
+
+// Cota LP del objetivo y distancia del resultado a ella
+static void printBound(const Problem &problem, int target,
+                       const ThroughputResult &bound, int achieved)
+{
+    const std::string &name = problem.resource_names[target];
+    if (bound.status == ThroughputResult::SKIPPED)
+    {
+        std::cout << "Cota LP de " << name << ": no calculada (problema demasiado grande)\n";
+        return;
+    }
+    if (bound.status == ThroughputResult::UNBOUNDED)
+    {
+        std::cout << "Cota LP de " << name << ": sin cota finita (ciclo con ganancia neta)\n";
+        return;
+    }
+    std::cout << "Cota LP de " << name << ": " << bound.stockBound()
+              << " (ritmo máximo " << bound.rate << "/ciclo en "
+              << bound.horizon << " ciclos)\n";
+    std::cout << "Gap de optimalidad: " << achieved << " / " << bound.stockBound()
+              << " (" << bound.gap(achieved) * 100 << "%)\n";
+    if (!bound.binding.empty())
+    {
+        std::cout << "Recursos limitantes:";
+        for (int r : bound.binding)
+            std::cout << " " << problem.resource_names[r]
+                      << " (" << bound.shadow_prices[r] << ")";
+        std::cout << "\n";
+    }
+}
+
+// Traza de un schedule del optimizador en orden de inicio. Se ordena en su
+// sitio (sin copia) y cada lote, o cada racha de instancias iguales, sale en
+// una sola escritura: la memoria no crece con el número de instancias
+static void writeSchedule(TraceWriter &trace, const Problem &problem,
+                          std::vector<ScheduledActivity> &schedule)
+{
+    std::sort(schedule.begin(), schedule.end(),
+        [](const ScheduledActivity &a, const ScheduledActivity &b) {
+            if (a.start_time != b.start_time)
+                return a.start_time < b.start_time;
+            return a.process < b.process;
+        });
+    size_t i = 0;
+    while (i < schedule.size())
+    {
+        const ScheduledActivity &first = schedule[i];
+        int count = 0;
+        for (; i < schedule.size() && schedule[i].start_time == first.start_time &&
+               schedule[i].process == first.process; i++)
+            count += schedule[i].count;
+        trace.write(first.start_time, problem.process_names[first.process], count);
+    }
+}
+
+static bool parseDelay(const std::string &arg, double &out)
+{
+    char *end;
+    double value = std::strtod(arg.c_str(), &end);
+    if (arg.empty() || *end != '\0' || !(value >= 0))
+        return false;
+    out = value;
+    return true;
+}
 
 int main(int argc, char **argv)
 {
-    if (argc != 2)
+    std::string file;
+    std::string trace_path;
+    std::string cache_path;
+    std::string compile_path;
+    std::string profile_path;
+    double delay = -1;   // segundos para el optimizador; < 0: sin límite
+    std::string engine;  // por defecto: sim sin delay, grasp con delay
+    int beam_width = 64;
+    
+    for (int i = 1; i < argc; i++)
     {
-        std::cout << "Usage: ./krpsim \"file\"\n";
-        return 1;
+        std::string arg = argv[i];
+        if (arg == "--trace" && i + 1 < argc)
+            trace_path = argv[++i];
+        else if (arg == "--cache" && i + 1 < argc)
+            cache_path = argv[++i];
+        else if (arg == "--compile" && i + 1 < argc)
+            compile_path = argv[++i];
+        else if (arg == "--profile" && i + 1 < argc)
+            profile_path = argv[++i];
+        else if (arg == "--engine" && i + 1 < argc)
+            engine = argv[++i];
+        else if (arg == "--beam-width" && i + 1 < argc)
+            beam_width = std::atoi(argv[++i]);
+        else if (file.empty() && arg[0] != '-')
+            file = arg;
+        else if (!file.empty() && delay < 0 && parseDelay(arg, delay))
+            continue;
+        else
+            return usage();
+    }
+    if (file.empty())
+        return usage();
+    if (engine != "" && engine != "sim" && engine != "grasp" && engine != "beam")
+        return usage();
+    if (!profile_path.empty())
+    {
+        if (Profiler::enabled)
+            Profiler::dumpAtExit(profile_path);
+        else
+            std::cerr << "--profile: compilado sin PROFILE=1, no hay datos\n";
     }
     
-    Parser p;
-    p.parse(argv[1]);
+    // Parseo directo a IDs densos (fichero mapeado, sin copias por token)
+    Problem problem;
+    uint64_t source_hash;
+    if (!loadProblem(file, cache_path, problem, source_hash))
+    {
+        std::cerr << "No se puede leer " << file << "\n";
+        return 1;
+    }
+
+    if (!compile_path.empty())
+    {
+        if (!ProblemCache::write(compile_path, problem, source_hash))
+        {
+            std::cerr << "No se puede escribir " << compile_path << "\n";
+            return 1;
+        }
+        std::cout << "Caché escrita en " << compile_path << " ("
+                  << problem.numResources() << " recursos, "
+                  << problem.numProcesses() << " procesos)\n";
+        return 0;
+    }
     
     std::cout << "== Stocks iniciales ==\n";
-    for (auto &kv : p.getStocks())
+    for (auto &kv : problem.namedStocks(problem.initial_stocks))
         std::cout << kv.first << ": " << kv.second << "\n";
 
-    // Lanzar simulador
-    Simulator sim(p);
-    sim.simulate();
+    // La traza se escribe en streaming mientras se simula (stdout por
+    // defecto) y no se guarda historial: memoria constante
+    TraceWriter trace;
+    if (!trace_path.empty() && !trace.open(trace_path))
+    {
+        std::cerr << "No se puede abrir " << trace_path << "\n";
+        return 1;
+    }
+
+    // Objetivo de optimize: y cota superior del recurso principal: elige el
+    // motor, corta la búsqueda y pondera prioridades
+    Objective objective = Objective::compile(problem);
+    int target = objective.primary();
+    ThroughputResult bound;
+    if (target >= 0)
+    {
+        bound = ThroughputBound(problem).compute(target);
+        objective.setBound(target, bound.stockBound());
+    }
+    if (engine.empty())
+        engine = objective.preferredEngine(delay >= 0);
+
+    int end_time;
+    std::vector<int> final_stocks;
+    if (engine != "sim")
+    {
+        // Optimizador (con presupuesto de tiempo si hay delay): se imprime
+        // el mejor schedule encontrado, en orden de inicio
+        int threads = std::max(1u, std::thread::hardware_concurrency());
+        Solution best;
+        if (engine == "beam")
+        {
+            BeamSearch beam(problem);
+            beam.setThreads(threads);
+            beam.setWidth(beam_width);
+            beam.setVerbose(false);
+            if (target >= 0)
+            {
+                beam.setObjective(objective);
+                beam.setStopStock(bound.stockBound());
+                if (bound.status == ThroughputResult::BOUNDED)
+                    beam.setShadowPrices(bound.shadow_prices);
+            }
+            best = delay >= 0 ? beam.solveFor(delay) : beam.solve();
+        }
+        else
+        {
+            GraspOptimizer grasp(problem);
+            grasp.setThreads(threads);
+            grasp.setVerbose(false);
+            grasp.setObjective(objective);
+            // Con recursos que maximizar las recetas se repiten: SGS paralelo
+            if (target >= 0)
+            {
+                grasp.setScheme(PARALLEL_SGS);
+                grasp.setStopStock(target, bound.stockBound());
+                if (bound.status == ThroughputResult::BOUNDED)
+                    grasp.setShadowPrices(bound.shadow_prices);
+            }
+            best = delay >= 0 ? grasp.solveFor(delay) : grasp.solve();
+        }
+
+        if (trace_path.empty())
+            std::cout << "\n== Traza ==\n";
+        std::cout << std::flush;
+        writeSchedule(trace, problem, best.schedule);
+        trace.flush();
+        end_time = best.schedule.empty() ? 0 : best.makespan;
+        final_stocks = best.final_stocks;
+        if (!best.complete)
+            std::cout << "\n(schedule parcial: se agotó el tiempo)\n";
+    }
+    else
+    {
+        Simulator sim(problem);
+        sim.setTrace(&trace);
+        sim.setRecordHistory(false);
+        sim.setObjective(objective);
+
+        if (trace_path.empty())
+            std::cout << "\n== Traza ==\n";
+        std::cout << std::flush;
+        sim.simulate();
+        trace.flush();
+        end_time = sim.getCurrentTime();
+        final_stocks = sim.getStockVector();
+    }
 
     // Resultado
     std::cout << "\n== Resultado final ==\n";
-    std::cout << "Tiempo total: " << sim.getCurrentTime() << "\n";
+    std::cout << "Tiempo total: " << end_time << "\n";
     std::cout << "Stocks finales:\n";
-    for (const auto &kv : sim.getStocksNow())
+    for (const auto &kv : problem.namedStocks(final_stocks))
         std::cout << "  " << kv.first << ": " << kv.second << "\n";
+    if (target >= 0)
+        printBound(problem, target, bound, final_stocks[target]);
     
     return 0;
 }
\ No newline at end of file
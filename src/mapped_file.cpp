@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mapped_file.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:48:05 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:48:05 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/mapped_file.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : data(nullptr), length(0), mapped(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string &path)
+{
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) < 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	if (S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED)
+		{
+			madvise(addr, st.st_size, MADV_SEQUENTIAL);
+			::close(fd);
+			data = (const char *)addr;
+			length = st.st_size;
+			mapped = true;
+			return true;
+		}
+	}
+
+	// Tuberías y demás: leer todo de una vez
+	char chunk[1 << 16];
+	ssize_t n;
+	while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+		fallback.append(chunk, n);
+	::close(fd);
+	data = fallback.data();
+	length = fallback.size();
+	return n == 0;
+}
+
+void MappedFile::close()
+{
+	if (mapped)
+		munmap((void *)data, length);
+	mapped = false;
+	fallback.clear();
+	data = nullptr;
+	length = 0;
+}
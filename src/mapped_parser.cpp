@@ -0,0 +1,216 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mapped_parser.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:12:30 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:12:30 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/mapped_parser.hpp"
+#include "../include/mapped_file.hpp"
+#include <charconv>
+#include <cstring>
+
+// Como std::stoi: espacios delante, signo opcional y basura detrás ignorada
+static bool parseInt(std::string_view s, int &out)
+{
+	size_t i = 0;
+	while (i < s.size() && isspace((unsigned char)s[i]))
+		i++;
+	if (i < s.size() && s[i] == '+')
+		i++;
+	auto res = std::from_chars(s.data() + i, s.data() + s.size(), out);
+	return res.ec == std::errc();
+}
+
+// Contenido entre el primer '(' desde start y el siguiente ')'
+static std::string_view betweenParens(std::string_view s, size_t start)
+{
+	size_t open = s.find('(', start);
+	if (open == std::string_view::npos)
+		return std::string_view();
+	size_t close = s.find(')', open);
+	if (close == std::string_view::npos)
+		return std::string_view();
+	return s.substr(open + 1, close - open - 1);
+}
+
+MappedParser::MappedParser(Problem &out) : problem(out), errors(0)
+{
+	if (problem.req_offsets.empty())
+		problem.req_offsets.push_back(0);
+	if (problem.prod_offsets.empty())
+		problem.prod_offsets.push_back(0);
+}
+
+bool MappedParser::parse(const std::string &path)
+{
+	MappedFile file;
+	if (!file.open(path))
+		return false;
+	parseBuffer(file.view());
+	return true;
+}
+
+void MappedParser::parseBuffer(std::string_view data)
+{
+	size_t line_no = 0;
+	size_t pos = 0;
+	while (pos < data.size())
+	{
+		const char *nl = (const char *)memchr(data.data() + pos, '\n', data.size() - pos);
+		size_t end = nl ? (size_t)(nl - data.data()) : data.size();
+		std::string_view line = data.substr(pos, end - pos);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		parseLine(line, ++line_no);
+		pos = end + 1;
+	}
+	problem.buildIndexes();
+}
+
+void MappedParser::parseLine(std::string_view line, size_t line_no)
+{
+	if (line.empty() || line[0] == '#')
+		return;
+
+	if (line.compare(0, 9, "optimize:") == 0)
+	{
+		parseOptimizeLine(line);
+		return;
+	}
+
+	size_t first = line.find(':');
+	if (first != std::string_view::npos && first == line.rfind(':'))
+	{
+		parseStockLine(line, first);
+		return;
+	}
+
+	if (first == std::string_view::npos || !parseProcessLine(line))
+	{
+		std::cerr << "Error parseando (línea " << line_no << "): " << line << "\n";
+		errors++;
+	}
+}
+
+// name:qty. Si el recurso ya tenía stock declarado se queda el primero
+void MappedParser::parseStockLine(std::string_view line, size_t colon)
+{
+	int qty = 0;
+	if (!parseInt(line.substr(colon + 1), qty))
+		qty = 0;   // como atoi
+
+	int id = problem.internResource(line.substr(0, colon));
+	if ((int)declared.size() <= id)
+		declared.resize(id + 1, 0);
+	if (!declared[id])
+	{
+		declared[id] = 1;
+		problem.initial_stocks[id] = qty;
+	}
+}
+
+// "item:qty;item2:qty2". Valida todo antes de tocar el Problem
+bool MappedParser::parseItems(std::string_view content, std::vector<Item> &out)
+{
+	out.clear();
+	if (content.empty())
+		return false;
+
+	size_t pos = 0;
+	while (pos <= content.size())
+	{
+		size_t semi = content.find(';', pos);
+		if (semi == std::string_view::npos)
+			semi = content.size();
+		std::string_view pair = content.substr(pos, semi - pos);
+		pos = semi + 1;
+		if (pair.empty() && semi == content.size())
+			break;   // getline no devuelve el trozo vacío final
+
+		size_t colon = pair.find(':');
+		if (colon == std::string_view::npos || colon == 0 || colon == pair.size() - 1)
+			return false;
+		int qty;
+		if (!parseInt(pair.substr(colon + 1), qty))
+			return false;
+
+		// Como en el map de Parser, un recurso repetido se queda el último
+		std::string_view name = pair.substr(0, colon);
+		bool found = false;
+		for (auto &item : out)
+			if (item.name == name)
+			{
+				item.qty = qty;
+				found = true;
+			}
+		if (!found)
+			out.push_back(Item{name, qty});
+	}
+	return true;
+}
+
+void MappedParser::appendItems(const std::vector<Item> &items,
+	std::vector<int> &resources, std::vector<int> &amounts)
+{
+	for (const auto &item : items)
+	{
+		resources.push_back(problem.internResource(item.name));
+		amounts.push_back(item.qty);
+	}
+}
+
+// Format: name:(needs):(results):delay
+bool MappedParser::parseProcessLine(std::string_view line)
+{
+	size_t firstColon = line.find(':');
+
+	if (!parseItems(betweenParens(line, firstColon), needs))
+		return false;
+
+	size_t firstClosePos = line.find(')', firstColon);
+	if (firstClosePos == std::string_view::npos)
+		return false;
+
+	if (!parseItems(betweenParens(line, firstClosePos), results))
+		return false;
+
+	size_t secondClosePos = line.find(')', firstClosePos + 1);
+	if (secondClosePos == std::string_view::npos)
+		return false;
+
+	size_t delayStart = line.find(':', secondClosePos);
+	if (delayStart == std::string_view::npos)
+		return false;
+
+	int delay;
+	if (!parseInt(line.substr(delayStart + 1), delay))
+		return false;
+
+	problem.process_names.emplace_back(line.substr(0, firstColon));
+	problem.delays.push_back(delay);
+	appendItems(needs, problem.req_resources, problem.req_amounts);
+	problem.req_offsets.push_back(problem.req_resources.size());
+	appendItems(results, problem.prod_resources, problem.prod_amounts);
+	problem.prod_offsets.push_back(problem.prod_resources.size());
+	return true;
+}
+
+void MappedParser::parseOptimizeLine(std::string_view line)
+{
+	std::string_view content = betweenParens(line, 0);
+	size_t pos = 0;
+	while (!content.empty() && pos < content.size())
+	{
+		size_t semi = content.find(';', pos);
+		if (semi == std::string_view::npos)
+			semi = content.size();
+		problem.optimizations.emplace_back(content.substr(pos, semi - pos));
+		pos = semi + 1;
+	}
+}
@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   objective.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 20:05:31 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 20:05:31 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/objective.hpp"
+
+Objective::Objective() : minimize_time(false)
+{
+}
+
+Objective Objective::compile(const Problem& problem)
+{
+    Objective o;
+    o.slot_of.assign(problem.numResources(), -1);
+    for (const std::string& name : problem.optimizations) {
+        if (name == "time") {
+            o.minimize_time = true;
+            continue;
+        }
+        int r = problem.resourceId(name);
+        if (r < 0 || o.slot_of[r] >= 0)
+            continue;
+        o.slot_of[r] = o.resources.size();
+        o.resources.push_back(r);
+        o.bounds.push_back(NO_BOUND);
+    }
+    o.feeds = upstreamOf(problem, o.resources);
+    return o;
+}
+
+std::vector<char> Objective::upstreamOf(const Problem& problem,
+                                        const std::vector<int>& targets)
+{
+    std::vector<char> upstream(problem.numProcesses(), 0);
+    std::vector<char> seen(problem.numResources(), 0);
+    std::vector<int> pending;
+    for (int r : targets)
+        if (!seen[r]) {
+            seen[r] = 1;
+            pending.push_back(r);
+        }
+
+    while (!pending.empty()) {
+        int r = pending.back();
+        pending.pop_back();
+        for (int k = problem.producer_offsets[r]; k < problem.producer_offsets[r + 1]; k++) {
+            int p = problem.producer_procs[k];
+            if (upstream[p])
+                continue;
+            upstream[p] = 1;
+            for (int q = problem.req_offsets[p]; q < problem.req_offsets[p + 1]; q++)
+                if (!seen[problem.req_resources[q]]) {
+                    seen[problem.req_resources[q]] = 1;
+                    pending.push_back(problem.req_resources[q]);
+                }
+        }
+    }
+    return upstream;
+}
+
+void Objective::setBound(int resource, int bound)
+{
+    if (slot_of[resource] >= 0)
+        bounds[slot_of[resource]] = bound;
+}
+
+int Objective::getBound(int resource) const
+{
+    return slot_of[resource] >= 0 ? bounds[slot_of[resource]] : NO_BOUND;
+}
+
+bool Objective::better(const std::vector<int>& a_stocks, int a_time,
+                       const std::vector<int>& b_stocks, int b_time) const
+{
+    for (int r : resources)
+        if (a_stocks[r] != b_stocks[r])
+            return a_stocks[r] > b_stocks[r];
+    return minimize_time && a_time < b_time;
+}
+
+const char* Objective::preferredEngine(bool has_delay) const
+{
+    if (!has_delay)
+        return "sim";
+    return resources.empty() ? "grasp" : "beam";
+}
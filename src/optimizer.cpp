@@ -11,76 +11,69 @@
 /* ************************************************************************** */
 
 #include "../include/optimizer.hpp"
+#include "../include/resource_profile.hpp"
+#include "../include/profiler.hpp"
 
-GraspOptimizer::GraspOptimizer(const std::vector<Process>& procs, 
-                               const std::map<std::string, int>& stocks,
-                               int max_t)
-    : processes(procs), initial_stocks(stocks), max_time(max_t)
+GraspOptimizer::GraspOptimizer(const Problem& problem, int max_t)
+    : problem(problem), initial_stocks(problem.initial_stocks), max_time(max_t),
+      requirements(problem),
+      num_iterations(0), alpha(0.3), seed(std::time(nullptr)), num_threads(1),
+      verbose(true), scheme(SERIAL_SGS), has_deadline(false), time_up(false), stop_resource(-1),
+      stop_stock(__INT_MAX__), bound_iteration(__INT_MAX__), next_commit(0), best_iteration(-1), best_makespan(__INT_MAX__)
 {
-    std::srand(std::time(nullptr));
     best_solution.makespan = __INT_MAX__;
+    
+    // Índice de productores: un bitset por recurso recortado a sus palabras
+    // con algún productor
+    producer_spans.assign(problem.numResources(), ProducerSpan{0, 0, 0});
+    for (int r = 0; r < problem.numResources(); r++) {
+        int begin = problem.producer_offsets[r];
+        int end = problem.producer_offsets[r + 1];
+        if (begin == end)
+            continue;
+        int lo = problem.producer_procs[begin] >> 6;
+        int hi = lo;
+        for (int k = begin; k < end; k++) {
+            lo = std::min(lo, problem.producer_procs[k] >> 6);
+            hi = std::max(hi, problem.producer_procs[k] >> 6);
+        }
+        ProducerSpan& span = producer_spans[r];
+        span.first = lo;
+        span.count = hi - lo + 1;
+        span.offset = producer_words.size();
+        producer_words.resize(producer_words.size() + span.count, 0);
+        for (int k = begin; k < end; k++) {
+            int p = problem.producer_procs[k];
+            producer_words[span.offset + (p >> 6) - lo] |= (uint64_t)1 << (p & 63);
+        }
+    }
 }
 
-bool GraspOptimizer::hasResourcesFor(const Process& proc, 
-                                     const std::map<std::string, int>& stocks) const
+bool GraspOptimizer::hasResourcesFor(int proc, 
+                                     const std::vector<int>& stocks) const
 {
-    // TODO: Recorrer proc.requisites
-	for (auto& p : proc.requisites)
-	{
-		for (auto& s : stocks)
-		{
-			if (s.first == p.first)
-				if (s.second < p.second)
-					return false;
-		}
-	}
-	return true;
-    // TODO: Para cada recurso, verificar que stocks[recurso] >= cantidad_necesaria
-    // TODO: Si alguno no tiene suficiente, return false
-    // TODO: Si todos están ok, return true
+	return problem.hasStocksFor(proc, stocks);
 }
 
-void GraspOptimizer::consumeResources(std::map<std::string, int>& stocks, 
-                                      const Process& proc) const
+void GraspOptimizer::consumeResources(std::vector<int>& stocks, 
+                                      int proc) const
 {
-    // TODO: Recorrer proc.requisites
-	for (auto& p : proc.requisites)
-		stocks[p.first] -= p.second;
-    // TODO: Para cada recurso: stocks[recurso] -= cantidad
+	problem.consume(proc, stocks);
 }
 
-void GraspOptimizer::produceResources(std::map<std::string, int>& stocks, 
-                                      const Process& proc) const
+void GraspOptimizer::produceResources(std::vector<int>& stocks, 
+                                      int proc) const
 {
-    // TODO: Recorrer proc.produces
-	for (auto& p : proc.requisites)
-	{
-		if (stocks.count(p.first) == 0)
-			stocks.insert(std::make_pair(p.first, 0));
-		stocks[p.first] += p.second;
-	}
-    // TODO: Para cada recurso: stocks[recurso] += cantidad
-    // TODO: Si el recurso no existe en stocks, crearlo
+	problem.produce(proc, stocks);
 }
 
-const Process* GraspOptimizer::findProcess(const std::string& name) const
+int GraspOptimizer::findProcess(const std::string& name) const
 {
-    // TODO: Recorrer processes
-	for (auto& p : this->processes)
-	{
-		if (p.name == name)
-			return (&p);
-	}
-	return (nullptr);
-    // TODO: Si encuentras uno con proc.name == name, return &proc
-    // TODO: Si no lo encuentras, return nullptr
+	return problem.processId(name);
 }
 
 int GraspOptimizer::calculateMakespan(const Solution& solution) const
 {
-    // TODO: Si solution.schedule está vacío, return 0
-    // TODO: Encontrar el finish_time máximo de todas las actividades
-    // TODO: Return ese tiempo máximo
 	if (solution.schedule.empty())
 		return (0);
 	int max = solution.schedule.begin()->finish_time;
@@ -93,112 +86,85 @@ int GraspOptimizer::calculateMakespan(const Solution& solution) const
 }
 
 bool GraspOptimizer::areDependenciesSatisfied(
-    const Process& proc,
-    const std::vector<bool>& scheduled,
-    const std::map<std::string, int>& stocks) const
+    int proc,
+    const Bitset& scheduled,
+    const std::vector<int>& stocks) const
 {
     // Para cada recurso que necesita este proceso
-    for (const auto& [recurso_necesario, cantidad] : proc.requisites) {
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++) {
+        int recurso_necesario = problem.req_resources[k];
         
         // ¿Hay stock inicial de este recurso?
-        if (stocks.count(recurso_necesario) && stocks.at(recurso_necesario) > 0) {
+        if (stocks[recurso_necesario] > 0) {
             continue;  // OK, hay stock, no necesita dependencia
         }
         
-        // No hay stock, así que ALGUIEN debe haberlo producido
-        bool alguien_lo_produjo = false;
-        
-        // Buscar quién produce este recurso
-        for (size_t i = 0; i < processes.size(); i++) {
-            
-            // ¿Este proceso produce el recurso que necesitamos?
-            if (processes[i].produces.count(recurso_necesario)) {
-                
-                // ¿Y además YA fue programado?
-                if (scheduled[i] == true) {
-                    alguien_lo_produjo = true;
-                    break;  // Ya encontramos a alguien, suficiente
-                }
-            }
-        }
-        
-        // Si nadie ha producido este recurso todavía
-        if (!alguien_lo_produjo) {
+        // No hay stock, así que ALGUIEN debe haberlo producido: algún
+        // productor del recurso tiene que estar ya programado
+        const ProducerSpan& span = producer_spans[recurso_necesario];
+        if (span.count == 0 ||
+            !scheduled.intersects(&producer_words[span.offset], span.first, span.count))
             return false;  // No se pueden satisfacer las dependencias
-        }
     }
     
     return true;  // Todas las dependencias están OK
 }
 
-std::vector<const Process*> GraspOptimizer::getEligibleProcesses(
-    const std::map<std::string, int>& current_stocks,
-    const std::vector<bool>& scheduled) const
+void GraspOptimizer::getEligibleProcesses(const std::vector<int>& current_stocks,
+                                          const Bitset& scheduled,
+                                          Bitset& ready,
+                                          std::vector<int>& eligible) const
 {
-    std::vector<const Process*> eligible;
+    PROFILE_SCOPE(PROF_ELIGIBLE);
+    eligible.clear();
     
-    // TODO: Recorrer processes con índice i
-	for (size_t i = 0; i < processes.size(); i++)
+	// Una pasada vectorizada da los que caben en los stocks; de ellos solo
+	// quedan los no programados
+	requirements.readyMask(current_stocks, ready);
+	ready.subtract(scheduled);
+	ready.forEachSet([&](int i)
 	{
-		if (scheduled[i] || !hasResourcesFor(processes[i], current_stocks) || !areDependenciesSatisfied(processes[i], scheduled, current_stocks))
-			continue;
-
-		eligible.emplace_back(processes[i]);
-	}
-    // TODO: Si scheduled[i] == true, skip (ya está programado)
-    // TODO: Si !hasResourcesFor(processes[i], current_stocks), skip
-    // TODO: Si !areDependenciesSatisfied(processes[i], scheduled, current_stocks), skip
-    // TODO: Si pasa todo, añadir &processes[i] al vector eligible
-    
-    return eligible;
+		if (areDependenciesSatisfied(i, scheduled, current_stocks))
+			eligible.push_back(i);
+	});
 }
 
-int GraspOptimizer::calculateSlack(const Process& proc,
-                                   const std::map<std::string, int>& current_stocks,
+int GraspOptimizer::calculateSlack(int proc,
+                                   const std::vector<int>& current_stocks,
                                    int current_time) const
 {
+    (void)current_stocks;
     int time_available = max_time - current_time;
     
     // Estimación simple: 
     // tiempo_necesario = delay del proceso + estimación de procesos posteriores
-    int num_outputs = proc.produces.size();
-    int estimated_subsequent = proc.delay * (num_outputs > 0 ? num_outputs : 1);
+    int num_outputs = problem.prod_offsets[proc + 1] - problem.prod_offsets[proc];
+    int estimated_subsequent = problem.delays[proc] * (num_outputs > 0 ? num_outputs : 1);
     
     int slack = time_available - estimated_subsequent;
     
     return slack;
 }
 
-double GraspOptimizer::calculateRank(const Process& proc) const
+double GraspOptimizer::calculateRank(int proc) const
 {
     double rank = 0.0;
     
-    // TODO: Cuando integres con simulator, recibir target_resources como parámetro
-    std::vector<std::string> target_resources;  // Vacío por ahora
-    
     // 1. Valor por lo que produce
-    for (const auto& [resource, qty] : proc.produces) {
+    for (int k = problem.prod_offsets[proc]; k < problem.prod_offsets[proc + 1]; k++) {
+        int resource = problem.prod_resources[k];
+        int qty = problem.prod_amounts[k];
         double value = qty;
         
-        // BONUS CRÍTICO: si produce un recurso objetivo
-        bool is_target = false;
-        for (const auto& target : target_resources) {
-            if (resource == target) {
-                rank += 100000.0 * qty;  // PRIORIDAD ABSOLUTA
-                is_target = true;
-                break;
-            }
-        }
+        // BONUS CRÍTICO: si produce un recurso objetivo de optimize:
+        bool is_target = objective.hasResources() && objective.slot(resource) >= 0;
+        if (is_target)
+            rank += 100000.0 * qty;  // PRIORIDAD ABSOLUTA
         
         // Si NO es objetivo, aplicar heurística de demanda
         if (!is_target) {
-            // Contar cuántos procesos necesitan este recurso
-            int num_processes_need_it = 0;
-            for (const auto& p : processes) {
-                if (p.requisites.count(resource)) {
-                    num_processes_need_it++;
-                }
-            }
+            // Cuántos procesos necesitan este recurso (índice inverso)
+            int num_processes_need_it = problem.numConsumers(resource);
             
             // Bonus por demanda: recursos muy demandados son valiosos
             // porque son productos intermedios necesarios
@@ -216,60 +182,71 @@ double GraspOptimizer::calculateRank(const Process& proc) const
     }
     
     // 2. Penalización por lo que consume (más suave)
-    for (const auto& [resource, qty] : proc.requisites) {
-        rank -= qty * 0.3;
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++) {
+        rank -= problem.req_amounts[k] * 0.3;
     }
     
     // 3. Pequeño bonus por delay
-    rank += proc.delay * 0.1;
+    rank += problem.delays[proc] * 0.1;
     
     return rank;
 }
 
-double GraspOptimizer::calculatePriority(const Process& proc, 
-                                        const std::map<std::string, int>& current_stocks,
+double GraspOptimizer::calculatePriority(int proc, 
+                                        const std::vector<int>& current_stocks,
                                         int current_time,
-                                        PriorityRule rule) const
+                                        PriorityRule rule,
+                                        Rng& rng) const
 {
+    // Con precios sombra lo que produce recursos limitantes desempata las
+    // reglas de prioridad entera (el peso no llega a 1) y suma en GRPW
+    double shadow = shadow_value.empty() ? 0.0 : shadow_value[proc];
+    
     switch (rule) {
         case LFT:  // Latest Finish Time (menor es mejor)
             // Prioridad = -1 * (max_time - current_time - proc.delay)
             // Cuanto menos tiempo quede, más urgente
-            return -(max_time - current_time - proc.delay);
+            return -(max_time - current_time - problem.delays[proc])
+                + SHADOW_TIE_WEIGHT * shadow;
             
         case MTS:  // Minimum Total Slack (menor slack = más urgente)
-            return -calculateSlack(proc, current_stocks, current_time);
+            return -calculateSlack(proc, current_stocks, current_time)
+                + SHADOW_TIE_WEIGHT * shadow;
             
         case GRPW: // Greatest Rank (mayor rank = más urgente)
-            return calculateRank(proc);
+            return calculateRank(proc) + SHADOW_RANK_WEIGHT * shadow;
             
         case SPT:  // Shortest Processing Time (menor delay = primero)
-            return -proc.delay;
+            return -problem.delays[proc] + SHADOW_TIE_WEIGHT * shadow;
             
         case RANDOM:
-            return rand() % 1000;  // Aleatorio entre 0-999
+            return rng.below(1000);  // Aleatorio entre 0-999
             
         default:
             return 0.0;
     }
 }
 
-const Process* GraspOptimizer::selectFromRCL(
-    const std::vector<const Process*>& eligible,
-    const std::map<std::string, int>& current_stocks,
+int GraspOptimizer::selectFromRCL(
+    const std::vector<int>& eligible,
+    const std::vector<int>& current_stocks,
     int current_time,
     PriorityRule rule,
-    double alpha) const
+    double alpha,
+    Rng& rng,
+    Workspace& ws) const
 {
+    PROFILE_SCOPE(PROF_SELECT_RCL);
     if (eligible.empty()) {
-        return nullptr;
+        return -1;
     }
     
     // 1. Calcular prioridad de cada proceso elegible
-    std::vector<std::pair<const Process*, double>> candidates;
+    std::vector<std::pair<int, double> >& candidates = ws.candidates;
+    candidates.clear();
     
-    for (const auto* proc : eligible) {
-        double priority = calculatePriority(*proc, current_stocks, current_time, rule);
+    for (int proc : eligible) {
+        double priority = calculatePriority(proc, current_stocks, current_time, rule, rng);
         candidates.push_back({proc, priority});
     }
     
@@ -288,7 +265,8 @@ const Process* GraspOptimizer::selectFromRCL(
     // Threshold: solo candidatos con prioridad >= threshold entran en RCL
     double threshold = worst_priority + alpha * (best_priority - worst_priority);
     
-    std::vector<const Process*> rcl;
+    std::vector<int>& rcl = ws.rcl;
+    rcl.clear();
     for (const auto& [proc, priority] : candidates) {
         if (priority >= threshold) {
             rcl.push_back(proc);
@@ -296,150 +274,590 @@ const Process* GraspOptimizer::selectFromRCL(
     }
     
     // 4. Elegir ALEATORIAMENTE uno de la RCL
-    int random_index = rand() % rcl.size();
+    int random_index = rng.below(rcl.size());
     return rcl[random_index];
 }
 
-Solution GraspOptimizer::constructGreedySolution(PriorityRule rule, double alpha)
+// Aplica las finalizaciones hasta current_time. running se compacta en su
+// sitio, conservando el orden de lanzamiento
+void GraspOptimizer::finishRunning(Workspace& ws, int current_time) const
 {
-    Solution solution;
-    
-    // Estado de la construcción
-    std::vector<bool> scheduled(processes.size(), false);
-    std::map<std::string, int> current_stocks = initial_stocks;
+    Solution& solution = ws.candidate;
+    size_t kept = 0;
+    for (size_t i = 0; i < ws.running.size(); i++) {
+        const auto [start_time, proc] = ws.running[i];
+        int finish_time = start_time + problem.delays[proc];
+        if (finish_time <= current_time) {
+            produceResources(solution.final_stocks, proc);
+            solution.schedule.push_back(ScheduledActivity(proc, start_time, finish_time));
+        } else {
+            ws.running[kept++] = ws.running[i];
+        }
+    }
+    ws.running.resize(kept);
+}
+
+void GraspOptimizer::constructGreedySolution(PriorityRule rule, double alpha, Rng& rng,
+                                             Workspace& ws)
+{
+    PROFILE_SCOPE(PROF_CONSTRUCT_GREEDY);
+    // Todo se reinicia sobre los buffers de ws, sin soltar su capacidad.
+    // Los stocks de la construcción son directamente los finales
+    Solution& solution = ws.candidate;
+    solution.schedule.clear();
+    solution.complete = true;
+    solution.final_stocks.assign(initial_stocks.begin(), initial_stocks.end());
+    std::vector<int>& current_stocks = solution.final_stocks;
+    ws.scheduled.assign(problem.numProcesses());
+    ws.running.clear();
     int current_time = 0;
     
-    // Lista de procesos en ejecución (start_time, process_index)
-    std::vector<std::pair<int, size_t>> running;
-    
     int scheduled_count = 0;
-    int total_processes = processes.size();
+    int total_processes = problem.numProcesses();
+    unsigned tick = 0;
     
     // Mientras haya procesos por programar
     while (scheduled_count < total_processes && current_time < max_time) {
-        
-        // 1. Terminar procesos que finalizan en este ciclo
-        std::vector<std::pair<int, size_t>> still_running;
-        
-        for (const auto& [start_time, proc_idx] : running) {
-            int finish_time = start_time + processes[proc_idx].delay;
-            
-            if (finish_time <= current_time) {
-                // Este proceso terminó
-                produceResources(current_stocks, processes[proc_idx]);
-                
-                // Añadir al schedule
-                solution.schedule.push_back(
-                    ScheduledActivity(processes[proc_idx].name, start_time, finish_time)
-                );
-            } else {
-                // Sigue ejecutándose
-                still_running.push_back({start_time, proc_idx});
-            }
+        // Sin tiempo: lo ya lanzado se deja terminar y el schedule queda
+        // parcial (factible, pero no comparable por makespan)
+        if (deadlineReached(tick)) {
+            solution.complete = false;
+            break;
         }
         
-        running = still_running;
+        // 1. Terminar procesos que finalizan en este ciclo
+        finishRunning(ws, current_time);
         
         // 2. Obtener procesos elegibles
-        std::vector<const Process*> eligible = getEligibleProcesses(current_stocks, scheduled);
+        getEligibleProcesses(current_stocks, ws.scheduled, ws.ready, ws.eligible);
         
         // 3. Si hay elegibles, programar UNO
-        if (!eligible.empty()) {
-            const Process* selected = selectFromRCL(eligible, current_stocks, current_time, rule, alpha);
+        if (!ws.eligible.empty()) {
+            int selected = selectFromRCL(ws.eligible, current_stocks, current_time,
+                                         rule, alpha, rng, ws);
             
-            if (selected != nullptr) {
-                // Encontrar el índice del proceso seleccionado
-                size_t proc_idx = 0;
-                for (size_t i = 0; i < processes.size(); i++) {
-                    if (&processes[i] == selected) {
-                        proc_idx = i;
-                        break;
-                    }
-                }
-                
+            if (selected >= 0) {
                 // Consumir recursos inmediatamente
-                consumeResources(current_stocks, *selected);
+                consumeResources(current_stocks, selected);
                 
                 // Marcar como programado
-                scheduled[proc_idx] = true;
+                ws.scheduled.set(selected);
                 scheduled_count++;
                 
                 // Añadir a la lista de ejecución
-                running.push_back({current_time, proc_idx});
+                ws.running.push_back({current_time, selected});
             }
         }
         
-        // 4. Avanzar el tiempo
-        current_time++;
+        // 4. Avanzar el tiempo. Sin elegibles nada cambia hasta la próxima
+        // finalización, así que los ciclos intermedios se saltan
+        if (ws.eligible.empty()) {
+            int next_time = max_time;
+            for (const auto& [start_time, proc] : ws.running)
+                next_time = std::min(next_time, start_time + problem.delays[proc]);
+            current_time = std::max(current_time + 1, next_time);
+        } else {
+            current_time++;
+        }
     }
     
     // Esperar a que terminen los procesos que aún están corriendo
-    while (!running.empty()) {
-        std::vector<std::pair<int, size_t>> still_running;
+    while (!ws.running.empty()) {
+        finishRunning(ws, current_time);
+        if (!ws.running.empty())
+            current_time++;
+    }
+    
+    // Calcular makespan
+    solution.makespan = calculateMakespan(solution);
+}
+
+bool GraspOptimizer::objectiveBounded(const std::vector<int>& stocks) const
+{
+    if (!objective.hasResources())
+        return false;
+    if (stop_resource >= 0 && stocks[stop_resource] >= stop_stock)
+        return true;
+    for (int r : objective.getResources())
+        if (stocks[r] < objective.getBound(r))
+            return false;
+    return true;
+}
+
+void GraspOptimizer::constructParallelSolution(PriorityRule rule, double alpha, Rng& rng,
+                                               Workspace& ws)
+{
+    PROFILE_SCOPE(PROF_CONSTRUCT_GREEDY);
+    Solution& solution = ws.candidate;
+    solution.schedule.clear();
+    solution.complete = true;
+    solution.final_stocks.assign(initial_stocks.begin(), initial_stocks.end());
+    std::vector<int>& current_stocks = solution.final_stocks;
+    std::vector<std::pair<int, int> >& events = ws.running;    // (fin, proceso)
+    events.clear();
+    const auto later = std::greater<std::pair<int, int> >();
+    bool only_feeding = objective.hasResources();
+    bool launching = true;
+    int current_time = 0;
+    unsigned tick = 0;
+    
+    while (true) {
+        // 1. Terminar todo lo que acaba en este instante
+        while (!events.empty() && events.front().first <= current_time) {
+            std::pop_heap(events.begin(), events.end(), later);
+            const auto [finish_time, proc] = events.back();
+            events.pop_back();
+            produceResources(current_stocks, proc);
+            solution.schedule.push_back(
+                ScheduledActivity(proc, finish_time - problem.delays[proc], finish_time));
+        }
+        
+        // Objetivo en su cota o fuera de horizonte: no se lanza nada más,
+        // solo se deja terminar lo que está en marcha
+        if (current_time >= max_time || objectiveBounded(current_stocks))
+            launching = false;
+        if (launching && deadlineReached(tick)) {
+            solution.complete = false;
+            launching = false;
+        }
         
-        for (const auto& [start_time, proc_idx] : running) {
-            int finish_time = start_time + processes[proc_idx].delay;
+        // 2. Llenar todos los huecos factibles: cada elección sale de la RCL
+        // y el proceso elegido puede volver a salir mientras quepa
+        if (launching) {
+            ws.eligible.clear();
+            requirements.readyMask(current_stocks, ws.ready);
+            ws.ready.forEachSet([&](int p) {
+                if (!only_feeding || objective.feedsObjective(p))
+                    ws.eligible.push_back(p);
+            });
             
-            if (finish_time <= current_time) {
-                produceResources(current_stocks, processes[proc_idx]);
-                solution.schedule.push_back(
-                    ScheduledActivity(processes[proc_idx].name, start_time, finish_time)
-                );
-            } else {
-                still_running.push_back({start_time, proc_idx});
+            while (!ws.eligible.empty()) {
+                // Sin tiempo: lo lanzado termina y el schedule queda parcial
+                if (deadlineReached(tick)) {
+                    solution.complete = false;
+                    launching = false;
+                    break;
+                }
+                int selected = selectFromRCL(ws.eligible, current_stocks, current_time,
+                                             rule, alpha, rng, ws);
+                consumeResources(current_stocks, selected);
+                events.push_back({current_time + problem.delays[selected], selected});
+                std::push_heap(events.begin(), events.end(), later);
+                
+                // Los stocks solo han bajado: basta con filtrar los elegibles.
+                // Uno que no gasta nada se lanza una vez por decisión, como en
+                // Problem::maxRuns; si no, cabría para siempre
+                bool repeatable = problem.consumesStock(selected);
+                size_t kept = 0;
+                for (int p : ws.eligible)
+                    if ((p != selected || repeatable) && hasResourcesFor(p, current_stocks))
+                        ws.eligible[kept++] = p;
+                ws.eligible.resize(kept);
             }
         }
         
-        running = still_running;
-        
-        if (!running.empty()) {
-            current_time++;
-        }
+        // 3. Saltar a la siguiente finalización, al menos un ciclo: lo de
+        // delay 0 termina en el ciclo en que empieza y sus productos llegan
+        // en el siguiente, como en el simulador
+        if (events.empty())
+            break;
+        current_time = std::max(current_time + 1, events.front().first);
     }
     
-    // Calcular makespan y stocks finales
     solution.makespan = calculateMakespan(solution);
-    solution.final_stocks = current_stocks;
+}
+
+// ============================================================================
+// FORWARD-BACKWARD IMPROVEMENT
+// ============================================================================
+
+// Construye el perfil de recursos de la solución con horizonte = makespan;
+// procs y starts son buffers del que llama
+static void buildProfile(ResourceProfile& profile, const std::vector<int>& initial_stocks,
+                         const Solution& solution, int horizon,
+                         std::vector<int>& procs, std::vector<int>& starts)
+{
+    procs.clear();
+    starts.clear();
+    for (const auto& act : solution.schedule) {
+        procs.push_back(act.process);
+        starts.push_back(act.start_time);
+    }
+    profile.build(initial_stocks, procs, starts, horizon);
+}
+
+void GraspOptimizer::localSearch(Solution& solution, Workspace& ws)
+{
+    PROFILE_SCOPE(PROF_LOCAL_SEARCH);
+    if (solution.schedule.empty())
+        return;
     
-    return solution;
+    // Una iteración FBI = justificar a la derecha y luego a la izquierda.
+    // Se repite mientras el makespan siga bajando
+    unsigned tick = DEADLINE_STRIDE - 1;   // cada ronda mira el reloj
+    for (int round = 0; round < 8; round++) {
+        if (deadlineReached(tick))
+            break;
+        int before = solution.makespan;
+        backwardPass(solution, ws);
+        forwardPass(solution, ws);
+        solution.makespan = calculateMakespan(solution);
+        if (solution.makespan >= before)
+            break;
+    }
 }
 
-Solution GraspOptimizer::solve(int iterations, double alpha_param)
+// Adelanta cada actividad (en orden de inicio) al primer instante factible.
+// El perfil da ese instante en O(log H) por requisito
+bool GraspOptimizer::forwardPass(Solution& solution, Workspace& ws)
 {
-    num_iterations = iterations;
-    alpha = alpha_param;
+    ResourceProfile& profile = ws.profile;
+    buildProfile(profile, initial_stocks, solution, solution.makespan, ws.procs, ws.starts);
     
-    std::cout << "Iniciando GRASP con " << iterations << " iteraciones (alpha=" << alpha << ")...\n";
+    std::vector<int>& order = ws.order;
+    order.resize(solution.schedule.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return solution.schedule[a].start_time < solution.schedule[b].start_time;
+    });
     
-    // Array de reglas a probar
-    PriorityRule rules[] = {LFT, MTS, GRPW, SPT, RANDOM};
-    int num_rules = 5;
+    // Cada movimiento deja el schedule factible: sin tiempo se puede
+    // cortar la pasada en cualquier punto
+    bool moved = false;
+    unsigned tick = 0;
+    for (int i : order) {
+        if (deadlineReached(tick))
+            break;
+        ScheduledActivity& act = solution.schedule[i];
+        int t = profile.earliestShift(act.process, act.start_time);
+        if (t < act.start_time && profile.tryShift(act.process, act.start_time, t)) {
+            act.finish_time = t + (act.finish_time - act.start_time);
+            act.start_time = t;
+            moved = true;
+        }
+    }
+    return moved;
+}
+
+// Retrasa cada actividad (en orden de fin descendente) lo máximo posible sin
+// pasar del makespan
+bool GraspOptimizer::backwardPass(Solution& solution, Workspace& ws)
+{
+    int makespan = solution.makespan;
+    ResourceProfile& profile = ws.profile;
+    buildProfile(profile, initial_stocks, solution, makespan, ws.procs, ws.starts);
     
-    for (int iter = 0; iter < num_iterations; iter++) {
-        // 1. Elegir una regla (rotar entre todas)
-        PriorityRule current_rule = rules[iter % num_rules];
-        
-        // 2. FASE CONSTRUCTIVA: Construir solución greedy randomizada
-        Solution candidate = constructGreedySolution(current_rule, alpha);
-        
-        // 3. FASE DE MEJORA: Aplicar búsqueda local
-        localSearch(candidate);
+    std::vector<int>& order = ws.order;
+    order.resize(solution.schedule.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return solution.schedule[a].finish_time > solution.schedule[b].finish_time;
+    });
+    
+    bool moved = false;
+    unsigned tick = 0;
+    for (int i : order) {
+        if (deadlineReached(tick))
+            break;
+        ScheduledActivity& act = solution.schedule[i];
+        int t = profile.latestShift(act.process, act.start_time, makespan);
+        if (t > act.start_time && profile.tryShift(act.process, act.start_time, t)) {
+            act.finish_time = t + (act.finish_time - act.start_time);
+            act.start_time = t;
+            moved = true;
+        }
+    }
+    return moved;
+}
+
+bool GraspOptimizer::isScheduleFeasible(const Solution& solution) const
+{
+    ResourceProfile profile(problem);
+    std::vector<int> procs, starts;
+    buildProfile(profile, initial_stocks, solution, calculateMakespan(solution), procs, starts);
+    return profile.feasible();
+}
+
+// Una iteración GRASP completa. Solo depende de (seed, iter), así que el
+// resultado es el mismo la ejecute el hilo que la ejecute
+void GraspOptimizer::runIteration(int iter, Workspace& ws)
+{
+    static const PriorityRule rules[] = {LFT, MTS, GRPW, SPT, RANDOM};
+    static const int num_rules = 5;
+    
+    Rng rng(seed, iter);
+    
+    // 1. Elegir una regla (rotar entre todas)
+    PriorityRule current_rule = rules[iter % num_rules];
+    
+    // 2. FASE CONSTRUCTIVA: Construir solución greedy randomizada
+    Clock::time_point started = has_deadline ? Clock::now() : Clock::time_point();
+    if (scheme == PARALLEL_SGS)
+        constructParallelSolution(current_rule, alpha, rng, ws);
+    else
+        constructGreedySolution(current_rule, alpha, rng, ws);
+    Solution& candidate = ws.candidate;
+    
+    // Con plazo se ofrece ya: si se acaba el tiempo en la búsqueda local el
+    // incumbente no se pierde
+    if (has_deadline)
+        offerSolution(candidate, iter);
+    
+    // 3. FASE DE MEJORA: Aplicar búsqueda local. Con plazo solo si cabe:
+    // reconstruir el perfil de un schedule enorme no se puede interrumpir
+    bool fits = true;
+    if (has_deadline) {
+        Clock::time_point now = Clock::now();
+        fits = now + (now - started) * LOCAL_SEARCH_COST < deadline;
+    }
+    if (candidate.complete && fits)
+        localSearch(candidate, ws);
+    
+    // 4. Actualizar mejor solución si es mejor
+    offerSolution(candidate, iter);
+}
+
+// Con objetivo manda el vector de objetivos y después el makespan; sin él
+// solo el makespan. A igualdad gana la iteración menor (determinista)
+bool GraspOptimizer::betterThanBest(const Solution& candidate, int iter) const
+{
+    if (objective.hasResources()) {
+        const std::vector<int>& a = candidate.final_stocks;
+        const std::vector<int>& b = best_solution.final_stocks;
+        if (objective.better(a, candidate.makespan, b, best_solution.makespan))
+            return true;
+        if (objective.better(b, best_solution.makespan, a, candidate.makespan))
+            return false;
+    }
+    return candidate.makespan < best_solution.makespan ||
+        (candidate.makespan == best_solution.makespan && iter < best_iteration);
+}
+
+// Incumbente compartido: sin objetivo la lectura atómica del makespan
+// descarta sin lock la mayoría de candidatos. Un schedule cortado por
+// tiempo solo vale si aún no hay nada, y cualquier schedule completo lo
+// sustituye
+void GraspOptimizer::offerSolution(Solution& candidate, int iter)
+{
+    bool reached = candidate.complete && stop_resource >= 0 &&
+                   candidate.final_stocks[stop_resource] >= stop_stock;
+    if (reached) {
+        // Las iteraciones por encima ya no hacen falta
+        int current = bound_iteration.load();
+        while (iter < current && !bound_iteration.compare_exchange_weak(current, iter))
+            ;
+    }
+    
+    if (orderedCommit()) {
+        std::lock_guard<std::mutex> lock(best_mutex);
+        commitInOrder(candidate, iter);
+        return;
+    }
+    
+    if (!objective.hasResources() &&
+        candidate.makespan > best_makespan.load(std::memory_order_relaxed))
+        return;
+    
+    std::lock_guard<std::mutex> lock(best_mutex);
+    if (beatsIncumbent(candidate, iter))
+        acceptSolution(candidate, iter, false);
+}
+
+bool GraspOptimizer::beatsIncumbent(const Solution& candidate, int iter) const
+{
+    if (!candidate.complete)
+        return best_iteration < 0;
+    if (!best_solution.complete || best_iteration < 0)
+        return true;
+    return betterThanBest(candidate, iter);
+}
+
+// Con take el incumbente se queda los buffers de candidate y le deja los
+// suyos; si no, se copia (candidate sigue en uso)
+void GraspOptimizer::acceptSolution(Solution& candidate, int iter, bool take)
+{
+    // Mejora estricta (sin contar el desempate por iteración)
+    bool improved = candidate.complete && (best_iteration < 0 || !best_solution.complete ||
+                                           betterThanBest(candidate, __INT_MAX__));
+    if (take)
+        std::swap(best_solution, candidate);
+    else
+        best_solution = candidate;
+    best_iteration = iter;
+    // Mientras el incumbente sea parcial no se descarta nada sin lock
+    best_makespan.store(best_solution.complete ? best_solution.makespan : __INT_MAX__,
+                        std::memory_order_relaxed);
+    if (improved && verbose)
+        std::cout << "  Iteración " << iter << ": Nueva mejor solución (makespan=" 
+                  << best_solution.makespan << ")\n";
+}
+
+// Guarda el resultado de iter en su hueco y luego incorpora, en orden,
+// todas las iteraciones consecutivas ya acabadas hasta bound_iteration.
+// Solo se guarda un candidato si ya mejora al incumbente: el incumbente
+// solo mejora, así que uno que no lo supera ahora tampoco lo hará al
+// llegarle el turno. Guardar e incorporar intercambian buffers, no copian
+void GraspOptimizer::commitInOrder(Solution& candidate, int iter)
+{
+    if (iter <= bound_iteration.load()) {
+        CommitSlot& slot = window[iter % window.size()];
+        slot.iter = iter;
+        slot.better = beatsIncumbent(candidate, iter);
+        if (slot.better)
+            std::swap(slot.solution, candidate);
         
-        // 4. Actualizar mejor solución si es mejor
-        if (candidate.makespan < best_solution.makespan) {
-            best_solution = candidate;
-            std::cout << "  Iteración " << iter << ": Nueva mejor solución (makespan=" 
-                      << best_solution.makespan << ")\n";
+        while (next_commit <= bound_iteration.load()) {
+            CommitSlot& head = window[next_commit % window.size()];
+            if (head.iter != next_commit)
+                break;
+            if (head.better && beatsIncumbent(head.solution, next_commit))
+                acceptSolution(head.solution, next_commit, true);
+            head.iter = -1;
+            next_commit++;
         }
+    }
+    // Avanzó next_commit o bajó bound_iteration: puede haber hilos esperando
+    commit_cv.notify_all();
+}
+
+// Con la ventana llena se espera a que la iteración más antigua pendiente
+// termine; esa la está ejecutando otro hilo, que nunca espera aquí
+bool GraspOptimizer::waitForSlot(int iter)
+{
+    std::unique_lock<std::mutex> lock(best_mutex);
+    commit_cv.wait(lock, [&] {
+        return iter < next_commit + (int)window.size() || iter > bound_iteration.load();
+    });
+    return iter <= bound_iteration.load();
+}
+
+void GraspOptimizer::workerLoop(std::atomic<int>& next_iter, std::atomic<int>& completed)
+{
+    int step = std::max(1, num_iterations / 10);
+    Workspace ws(problem);
+    
+    unsigned tick = DEADLINE_STRIDE - 1;
+    for (int iter = next_iter++; iter < num_iterations; iter = next_iter++) {
+        // La iteración 0 siempre corre: garantiza que haya un incumbente
+        if (iter > 0 && (deadlineReached(tick) || iter > bound_iteration.load()))
+            break;
+        if (orderedCommit() && !waitForSlot(iter))
+            break;
+        tick = DEADLINE_STRIDE - 1;
+        runIteration(iter, ws);
         
         // Mostrar progreso cada 10%
-        if ((iter + 1) % (iterations / 10) == 0) {
-            std::cout << "  Progreso: " << (iter + 1) << "/" << iterations 
-                      << " (" << ((iter + 1) * 100 / iterations) << "%)\n";
+        int done = ++completed;
+        if (verbose && done % step == 0) {
+            std::lock_guard<std::mutex> lock(best_mutex);
+            std::cout << "  Progreso: " << done << "/" << num_iterations 
+                      << " (" << (done * 100 / num_iterations) << "%)\n";
+        }
+    }
+}
+
+bool GraspOptimizer::deadlineReached(unsigned& tick)
+{
+    if (!has_deadline)
+        return false;
+    if (time_up.load(std::memory_order_relaxed))
+        return true;
+    if (++tick % DEADLINE_STRIDE != 0)
+        return false;
+    if (Clock::now() < deadline)
+        return false;
+    time_up.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+Solution GraspOptimizer::solve(int iterations, double alpha_param)
+{
+    alpha = alpha_param;
+    has_deadline = false;
+    
+    if (verbose)
+        std::cout << "Iniciando GRASP con " << iterations << " iteraciones (alpha=" << alpha
+                  << ", hilos=" << num_threads << ", semilla=" << seed << ")...\n";
+    
+    return runWorkers(iterations);
+}
+
+Solution GraspOptimizer::solveFor(double seconds, double alpha_param)
+{
+    alpha = alpha_param;
+    has_deadline = true;
+    time_up.store(false);
+    deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(0.0, seconds)));
+    
+    if (verbose)
+        std::cout << "Iniciando GRASP durante " << seconds << " s (alpha=" << alpha
+                  << ", hilos=" << num_threads << ", semilla=" << seed << ")...\n";
+    
+    return runWorkers(std::numeric_limits<int>::max());
+}
+
+// Valor de lo que produce cada proceso a precios sombra (el objetivo
+// principal vale 1), dividido por el mayor para que quede en [0, 1]
+void GraspOptimizer::prepareShadowValues()
+{
+    shadow_value.clear();
+    int target = objective.primary();
+    if (shadow_prices.empty() || target < 0)
+        return;
+    shadow_value.assign(problem.numProcesses(), 0.0);
+    double top = 0.0;
+    for (int p = 0; p < problem.numProcesses(); p++) {
+        double value = 0.0;
+        for (int k = problem.prod_offsets[p]; k < problem.prod_offsets[p + 1]; k++) {
+            int r = problem.prod_resources[k];
+            double price = r == target ? 1.0 : shadow_prices[r];
+            value += price * problem.prod_amounts[k];
         }
+        shadow_value[p] = value;
+        top = std::max(top, value);
+    }
+    if (top <= 0.0) {
+        shadow_value.clear();
+        return;
+    }
+    for (double& v : shadow_value)
+        v /= top;
+}
+
+Solution GraspOptimizer::runWorkers(int iterations)
+{
+    num_iterations = iterations;
+    prepareShadowValues();
+    bound_iteration.store(__INT_MAX__);
+    next_commit = 0;
+    
+    // Las iteraciones se reparten dinámicamente: cada hilo coge la siguiente
+    std::atomic<int> next_iter(0);
+    std::atomic<int> completed(0);
+    int workers = std::min(num_threads, std::max(1, iterations));
+    
+    // Dos huecos por hilo: un hilo puede adelantarse a la iteración más
+    // antigua pendiente sin esperar casi nunca
+    window.resize(orderedCommit() ? 2 * workers : 0);
+    for (CommitSlot& slot : window)
+        slot.iter = -1;
+    
+    if (workers == 1) {
+        workerLoop(next_iter, completed);
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < workers; t++)
+            pool.emplace_back(&GraspOptimizer::workerLoop, this,
+                              std::ref(next_iter), std::ref(completed));
+        for (auto& th : pool)
+            th.join();
     }
     
-    std::cout << "GRASP completado. Mejor makespan encontrado: " << best_solution.makespan << "\n";
+    if (verbose)
+        std::cout << "GRASP completado. Mejor makespan encontrado: " << best_solution.makespan << "\n";
     
     return best_solution;
 }
@@ -31,8 +31,10 @@ void Parser::parse(std::string file)
 	std::ifstream filestream(file);
 	std::string line;
 	std::vector<std::string> splited;
+	size_t line_no = 0;
 	while (std::getline(filestream, line))
 	{
+		line_no++;
 		if (line.empty() || line[0] == '#')
 			continue;
 		if (line.find("optimize:") == 0) // Empieza con "optimize:"
@@ -49,7 +51,7 @@ void Parser::parse(std::string file)
 			Process p;
 			if (!parseProcessLine(line, p))
 			{
-				std::cerr << "Error parseando: " << line << "\n";
+				std::cerr << "Error parseando (línea " << line_no << "): " << line << "\n";
 				continue;
 			}
 			this->processes.push_back(p);
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   problem.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:02:11 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 10:02:11 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/problem.hpp"
+
+Problem Problem::compile(Parser &parser)
+{
+	Problem problem;
+
+	problem.req_offsets.push_back(0);
+	problem.prod_offsets.push_back(0);
+
+	// Los stocks iniciales van primero para que sus ids sigan el orden del map
+	for (const auto &[name, qty] : parser.getStocks())
+	{
+		int id = problem.internResource(name);
+		problem.initial_stocks[id] = qty;
+	}
+
+	for (const auto &proc : parser.getAllProcesses())
+		problem.addProcess(proc);
+
+	problem.optimizations = parser.getOptimizations();
+	problem.buildIndexes();
+	return problem;
+}
+
+int Problem::internResource(std::string_view name)
+{
+	int id = resource_ids.insert(name, resource_names);
+	if (id == (int)initial_stocks.size())
+		initial_stocks.push_back(0);
+	return id;
+}
+
+void Problem::addProcess(const Process &proc)
+{
+	process_names.push_back(proc.name);
+	delays.push_back(proc.delay);
+
+	for (const auto &[resource, qty] : proc.requisites)
+	{
+		req_resources.push_back(internResource(resource));
+		req_amounts.push_back(qty);
+	}
+	req_offsets.push_back(req_resources.size());
+
+	for (const auto &[resource, qty] : proc.produces)
+	{
+		prod_resources.push_back(internResource(resource));
+		prod_amounts.push_back(qty);
+	}
+	prod_offsets.push_back(prod_resources.size());
+}
+
+// Transpone un CSR proceso -> recurso en uno recurso -> proceso
+static void transpose(int num_resources, int num_processes,
+	const std::vector<int> &offsets, const std::vector<int> &resources,
+	std::vector<int> &out_offsets, std::vector<int> &out_procs)
+{
+	// Contar por recurso y acumular (counting sort)
+	out_offsets.assign(num_resources + 1, 0);
+	for (int r : resources)
+		out_offsets[r + 1]++;
+	for (int r = 0; r < num_resources; r++)
+		out_offsets[r + 1] += out_offsets[r];
+
+	out_procs.resize(resources.size());
+	std::vector<int> fill(out_offsets.begin(), out_offsets.end() - 1);
+	for (int p = 0; p < num_processes; p++)
+		for (int k = offsets[p]; k < offsets[p + 1]; k++)
+			out_procs[fill[resources[k]]++] = p;
+}
+
+void Problem::buildIndexes()
+{
+	transpose(numResources(), numProcesses(), req_offsets, req_resources,
+		consumer_offsets, consumer_procs);
+	transpose(numResources(), numProcesses(), prod_offsets, prod_resources,
+		producer_offsets, producer_procs);
+	indexProcessNames();
+}
+
+// Con nombres repetidos processId devuelve el primer proceso
+void Problem::indexProcessNames()
+{
+	process_ids.clear();
+	for (int p = 0; p < numProcesses(); p++)
+		process_ids.index(p, process_names);
+}
+
+int Problem::resourceId(std::string_view name) const
+{
+	return resource_ids.find(name, resource_names);
+}
+
+int Problem::processId(std::string_view name) const
+{
+	return process_ids.find(name, process_names);
+}
+
+bool Problem::consumes(int proc, int resource) const
+{
+	for (int k = req_offsets[proc]; k < req_offsets[proc + 1]; k++)
+		if (req_resources[k] == resource)
+			return true;
+	return false;
+}
+
+// Falso si el proceso no gasta nada: se podría lanzar infinitas veces
+bool Problem::consumesStock(int proc) const
+{
+	for (int k = req_offsets[proc]; k < req_offsets[proc + 1]; k++)
+		if (req_amounts[k] > 0)
+			return true;
+	return false;
+}
+
+// Un proceso que no gasta nada se lanza una sola vez por decisión
+int Problem::maxRuns(int proc, const std::vector<int> &stocks) const
+{
+	if (!hasStocksFor(proc, stocks))
+		return 0;
+	int runs = std::numeric_limits<int>::max();
+	for (int k = req_offsets[proc]; k < req_offsets[proc + 1]; k++)
+		if (req_amounts[k] > 0)
+			runs = std::min(runs, stocks[req_resources[k]] / req_amounts[k]);
+	return consumesStock(proc) ? runs : 1;
+}
+
+bool Problem::producesResource(int proc, int resource) const
+{
+	for (int k = prod_offsets[proc]; k < prod_offsets[proc + 1]; k++)
+		if (prod_resources[k] == resource)
+			return true;
+	return false;
+}
+
+std::map<std::string, int> Problem::namedStocks(const std::vector<int> &stocks) const
+{
+	std::map<std::string, int> named;
+	for (size_t r = 0; r < stocks.size(); r++)
+		named[resource_names[r]] = stocks[r];
+	return named;
+}
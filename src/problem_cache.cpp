@@ -0,0 +1,221 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   problem_cache.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:48:05 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 16:48:05 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/problem_cache.hpp"
+#include "../include/mapped_file.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+static const char MAGIC[8] = {'K', 'R', 'P', 'S', 'I', 'M', 'C', '\0'};
+
+// ============================================================================
+// ESCRITURA
+// ============================================================================
+
+static void putInts(std::string &out, const std::vector<int> &v)
+{
+	out.append((const char *)v.data(), v.size() * sizeof(int32_t));
+}
+
+static void putStrings(std::string &out, const std::vector<std::string> &v)
+{
+	std::vector<int> offsets(1, 0);
+	for (const auto &s : v)
+		offsets.push_back(offsets.back() + s.size());
+	putInts(out, offsets);
+	for (const auto &s : v)
+		out.append(s);
+}
+
+uint64_t ProblemCache::hashSource(std::string_view content)
+{
+	return NameTable::hash(content);
+}
+
+bool ProblemCache::isCache(const std::string &path)
+{
+	std::ifstream in(path, std::ios::binary);
+	char magic[sizeof(MAGIC)];
+	return in.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool ProblemCache::write(const std::string &path, const Problem &problem,
+	uint64_t source_hash)
+{
+	std::string payload;
+	putInts(payload, problem.initial_stocks);
+	putInts(payload, problem.delays);
+	putInts(payload, problem.req_offsets);
+	putInts(payload, problem.req_resources);
+	putInts(payload, problem.req_amounts);
+	putInts(payload, problem.prod_offsets);
+	putInts(payload, problem.prod_resources);
+	putInts(payload, problem.prod_amounts);
+	putInts(payload, problem.consumer_offsets);
+	putInts(payload, problem.consumer_procs);
+	putInts(payload, problem.producer_offsets);
+	putInts(payload, problem.producer_procs);
+	putStrings(payload, problem.resource_names);
+	putStrings(payload, problem.process_names);
+	putStrings(payload, problem.optimizations);
+
+	Header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, MAGIC, sizeof(MAGIC));
+	h.version = VERSION;
+	h.header_size = sizeof(Header);
+	h.source_hash = source_hash;
+	h.payload_size = payload.size();
+	h.num_resources = problem.numResources();
+	h.num_processes = problem.numProcesses();
+	h.num_requisites = problem.req_resources.size();
+	h.num_products = problem.prod_resources.size();
+	h.num_optimizations = problem.optimizations.size();
+
+	// Se escribe aparte y se renombra: nunca queda una caché a medias
+	std::string tmp = path + ".tmp";
+	FILE *f = fopen(tmp.c_str(), "wb");
+	if (!f)
+		return false;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+		&& fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+	ok = (fclose(f) == 0) && ok;
+	if (!ok || rename(tmp.c_str(), path.c_str()) != 0)
+	{
+		remove(tmp.c_str());
+		return false;
+	}
+	return true;
+}
+
+// ============================================================================
+// LECTURA
+// ============================================================================
+
+namespace
+{
+	// Cursor sobre el payload mapeado; se queda en !ok al salirse del rango
+	struct Reader
+	{
+		const char *pos;
+		const char *end;
+		bool ok;
+
+		bool ints(std::vector<int> &out, int64_t n)
+		{
+			size_t bytes = n * sizeof(int32_t);
+			if (!ok || n < 0 || bytes > (size_t)(end - pos))
+				return ok = false;
+			out.resize(n);
+			memcpy(out.data(), pos, bytes);
+			pos += bytes;
+			return true;
+		}
+
+		bool strings(std::vector<std::string> &out, int n)
+		{
+			std::vector<int> offsets;
+			if (!ints(offsets, (int64_t)n + 1))
+				return false;
+			if (offsets[0] != 0 || (size_t)offsets[n] > (size_t)(end - pos))
+				return ok = false;
+			out.clear();
+			out.reserve(n);
+			for (int i = 0; i < n; i++)
+			{
+				if (offsets[i + 1] < offsets[i])
+					return ok = false;
+				out.emplace_back(pos + offsets[i], offsets[i + 1] - offsets[i]);
+			}
+			pos += offsets[n];
+			return true;
+		}
+	};
+}
+
+// Los índices se usan sin comprobar en todo el programa: validar una vez aquí
+static bool validCsr(const std::vector<int> &offsets, const std::vector<int> &ids,
+	int limit)
+{
+	if (offsets.front() != 0 || offsets.back() != (int)ids.size())
+		return false;
+	for (size_t i = 1; i < offsets.size(); i++)
+		if (offsets[i] < offsets[i - 1])
+			return false;
+	for (int id : ids)
+		if (id < 0 || id >= limit)
+			return false;
+	return true;
+}
+
+bool ProblemCache::load(const std::string &path, Problem &out,
+	uint64_t expected_hash)
+{
+	out = Problem();
+
+	MappedFile file;
+	if (!file.open(path) || file.size() < sizeof(Header))
+		return false;
+
+	Header h;
+	memcpy(&h, file.view().data(), sizeof(h));
+	if (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION
+		|| h.header_size != sizeof(Header)
+		|| h.payload_size != file.size() - sizeof(Header))
+		return false;
+	if (expected_hash != 0 && h.source_hash != expected_hash)
+		return false;
+
+	int R = h.num_resources;
+	int P = h.num_processes;
+	Reader in{file.view().data() + sizeof(Header),
+		file.view().data() + file.size(), R >= 0 && P >= 0};
+
+	std::vector<std::string> names;
+	in.ints(out.initial_stocks, R);
+	in.ints(out.delays, P);
+	in.ints(out.req_offsets, (int64_t)P + 1);
+	in.ints(out.req_resources, h.num_requisites);
+	in.ints(out.req_amounts, h.num_requisites);
+	in.ints(out.prod_offsets, (int64_t)P + 1);
+	in.ints(out.prod_resources, h.num_products);
+	in.ints(out.prod_amounts, h.num_products);
+	in.ints(out.consumer_offsets, (int64_t)R + 1);
+	in.ints(out.consumer_procs, h.num_requisites);
+	in.ints(out.producer_offsets, (int64_t)R + 1);
+	in.ints(out.producer_procs, h.num_products);
+	in.strings(names, R);
+	in.strings(out.process_names, P);
+	in.strings(out.optimizations, h.num_optimizations);
+
+	if (!in.ok || in.pos != in.end
+		|| !validCsr(out.req_offsets, out.req_resources, R)
+		|| !validCsr(out.prod_offsets, out.prod_resources, R)
+		|| !validCsr(out.consumer_offsets, out.consumer_procs, P)
+		|| !validCsr(out.producer_offsets, out.producer_procs, P))
+	{
+		out = Problem();
+		return false;
+	}
+
+	// Las tablas hash no se guardan: se rehacen a partir de los nombres
+	for (const auto &name : names)
+		out.internResource(name);
+	out.indexProcessNames();
+	if (out.numResources() != R)   // nombres repetidos: caché corrupta
+	{
+		out = Problem();
+		return false;
+	}
+	return true;
+}
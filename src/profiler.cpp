@@ -0,0 +1,173 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profiler.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 18:31:27 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 18:31:27 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/profiler.hpp"
+
+#ifdef KRPSIM_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    struct PhaseStats
+    {
+        std::atomic<unsigned long long> calls;
+        std::atomic<unsigned long long> nanos;
+        std::atomic<unsigned long long> allocs;
+        std::atomic<unsigned long long> alloc_bytes;
+    };
+
+    // Se inicializan a cero antes de cualquier constructor dinámico, así
+    // que el operator new puede usarlos desde el primer momento
+    PhaseStats phases[PROF_NUM_PHASES];
+    PhaseStats total;
+    thread_local int current_phase = -1;
+
+    const char *phase_names[PROF_NUM_PHASES] = {
+        "checkRunningProcs",
+        "executableProcesses_Smart",
+        "smart_score",
+        "constructGreedySolution",
+        "getEligibleProcesses",
+        "selectFromRCL",
+        "localSearch",
+    };
+
+    char dump_path[4096];
+
+    long long nowNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void countAlloc(size_t size)
+    {
+        total.allocs.fetch_add(1, std::memory_order_relaxed);
+        total.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (current_phase >= 0)
+        {
+            phases[current_phase].allocs.fetch_add(1, std::memory_order_relaxed);
+            phases[current_phase].alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+
+    void *countedAlloc(size_t size)
+    {
+        countAlloc(size);
+        void *p = std::malloc(size ? size : 1);
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    void dumpHandler()
+    {
+        Profiler::dump(dump_path);
+    }
+}
+
+Profiler::Scope::Scope(ProfilePhase phase)
+    : phase(phase), previous(current_phase), start(nowNanos())
+{
+    current_phase = phase;
+}
+
+Profiler::Scope::~Scope()
+{
+    phases[phase].calls.fetch_add(1, std::memory_order_relaxed);
+    phases[phase].nanos.fetch_add(nowNanos() - start, std::memory_order_relaxed);
+    current_phase = previous;
+}
+
+void Profiler::dumpAtExit(const std::string &path)
+{
+    bool first = dump_path[0] == '\0';
+    snprintf(dump_path, sizeof(dump_path), "%s", path.c_str());
+    if (first)
+        std::atexit(dumpHandler);
+}
+
+// Con FILE* y sin std::string: no queremos reservas mientras se vuelca
+bool Profiler::dump(const std::string &path)
+{
+    FILE *f = fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+    fprintf(f, "{\n  \"phases\": {\n");
+    for (int i = 0; i < PROF_NUM_PHASES; i++)
+    {
+        unsigned long long calls = phases[i].calls.load();
+        unsigned long long nanos = phases[i].nanos.load();
+        fprintf(f, "    \"%s\": {\"calls\": %llu, \"seconds\": %.9f, "
+            "\"ns_per_call\": %.1f, \"allocs\": %llu, \"alloc_bytes\": %llu}%s\n",
+            phase_names[i], calls, nanos / 1e9,
+            calls ? (double)nanos / calls : 0.0,
+            phases[i].allocs.load(), phases[i].alloc_bytes.load(),
+            i + 1 < PROF_NUM_PHASES ? "," : "");
+    }
+    fprintf(f, "  },\n  \"total_allocs\": %llu,\n  \"total_alloc_bytes\": %llu\n}\n",
+        total.allocs.load(), total.alloc_bytes.load());
+    return fclose(f) == 0;
+}
+
+// ============================================================================
+// OPERATOR NEW CONTADO
+// ============================================================================
+
+void *operator new(size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    countAlloc(size);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    countAlloc(size);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
@@ -0,0 +1,173 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   requirement_matrix.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:34:50 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 21:34:50 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/requirement_matrix.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+# define KRPSIM_X86
+# include <immintrin.h>
+#endif
+
+static const int PAD_AMOUNT = std::numeric_limits<int>::min();
+static const unsigned ALL_LANES = (1u << RequirementMatrix::LANES) - 1;
+
+RequirementMatrix::RequirementMatrix(const Problem& problem, Isa requested)
+    : num_processes(problem.numProcesses()),
+      num_blocks((problem.numProcesses() + LANES - 1) / LANES)
+{
+    row_offsets.push_back(0);
+    for (int b = 0; b < num_blocks; b++) {
+        int first = b * LANES;
+        int last = std::min(first + LANES, num_processes);
+        int rows = 0;
+        for (int p = first; p < last; p++)
+            rows = std::max(rows, problem.req_offsets[p + 1] - problem.req_offsets[p]);
+
+        for (int k = 0; k < rows; k++) {
+            for (int lane = 0; lane < LANES; lane++) {
+                int p = first + lane;
+                if (p < last && k < problem.req_offsets[p + 1] - problem.req_offsets[p]) {
+                    resources.push_back(problem.req_resources[problem.req_offsets[p] + k]);
+                    amounts.push_back(problem.req_amounts[problem.req_offsets[p] + k]);
+                } else {
+                    resources.push_back(0);
+                    amounts.push_back(PAD_AMOUNT);
+                }
+            }
+        }
+        row_offsets.push_back(row_offsets.back() + rows);
+    }
+
+    // Lo pedido no puede ir más allá de lo que tiene la CPU
+    isa = std::min(requested, bestIsa());
+    if (isa == AVX2)
+        kernel = avx2Kernel;
+    else if (isa == SSE2)
+        kernel = sse2Kernel;
+    else
+        kernel = scalarKernel;
+}
+
+RequirementMatrix::Isa RequirementMatrix::bestIsa()
+{
+#ifdef KRPSIM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SSE2;
+#endif
+    return SCALAR;
+}
+
+const char* RequirementMatrix::isaName(Isa isa)
+{
+    if (isa == AVX2)
+        return "avx2";
+    if (isa == SSE2)
+        return "sse2";
+    return "escalar";
+}
+
+void RequirementMatrix::readyMask(const std::vector<int>& stocks, Bitset& ready) const
+{
+    ready.assign(num_processes);
+    kernel(*this, stocks.data(), ready.data());
+
+    // Los carriles de relleno del último bloque no tienen requisitos
+    if (num_processes & 63)
+        ready.data()[ready.numWords() - 1] &= ((uint64_t)1 << (num_processes & 63)) - 1;
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+//
+// Todos recorren los bloques igual: fail acumula un bit por carril con
+// requisito > stock y el bloque b deja sus LANES bits listos en la palabra
+// b / 8. Un bloque en el que ya ha fallado todo deja de mirar filas.
+
+void RequirementMatrix::scalarKernel(const RequirementMatrix& m, const int* stocks, uint64_t* words)
+{
+    for (int b = 0; b < m.num_blocks; b++) {
+        unsigned fail = 0;
+        for (int row = m.row_offsets[b]; row < m.row_offsets[b + 1] && fail != ALL_LANES; row++) {
+            const int* res = &m.resources[row * LANES];
+            const int* amt = &m.amounts[row * LANES];
+            for (int lane = 0; lane < LANES; lane++)
+                fail |= (unsigned)(amt[lane] > stocks[res[lane]]) << lane;
+        }
+        words[b >> 3] |= (uint64_t)(~fail & ALL_LANES) << ((b & 7) * LANES);
+    }
+}
+
+#ifdef KRPSIM_X86
+
+// SSE2 no tiene gather: los stocks se cargan carril a carril y la
+// comparación va de 4 en 4
+__attribute__((target("sse2")))
+void RequirementMatrix::sse2Kernel(const RequirementMatrix& m, const int* stocks, uint64_t* words)
+{
+    for (int b = 0; b < m.num_blocks; b++) {
+        __m128i fail_lo = _mm_setzero_si128();
+        __m128i fail_hi = _mm_setzero_si128();
+        unsigned fail = 0;
+        for (int row = m.row_offsets[b]; row < m.row_offsets[b + 1] && fail != ALL_LANES; row++) {
+            const int* res = &m.resources[row * LANES];
+            const int* amt = &m.amounts[row * LANES];
+            __m128i st_lo = _mm_set_epi32(stocks[res[3]], stocks[res[2]],
+                                          stocks[res[1]], stocks[res[0]]);
+            __m128i st_hi = _mm_set_epi32(stocks[res[7]], stocks[res[6]],
+                                          stocks[res[5]], stocks[res[4]]);
+            __m128i amt_lo = _mm_loadu_si128((const __m128i*)amt);
+            __m128i amt_hi = _mm_loadu_si128((const __m128i*)(amt + 4));
+            fail_lo = _mm_or_si128(fail_lo, _mm_cmpgt_epi32(amt_lo, st_lo));
+            fail_hi = _mm_or_si128(fail_hi, _mm_cmpgt_epi32(amt_hi, st_hi));
+            fail = _mm_movemask_ps(_mm_castsi128_ps(fail_lo))
+                 | _mm_movemask_ps(_mm_castsi128_ps(fail_hi)) << 4;
+        }
+        words[b >> 3] |= (uint64_t)(~fail & ALL_LANES) << ((b & 7) * LANES);
+    }
+}
+
+// Una fila entera por instrucción: gather de los 8 stocks y cmpgt
+__attribute__((target("avx2")))
+void RequirementMatrix::avx2Kernel(const RequirementMatrix& m, const int* stocks, uint64_t* words)
+{
+    for (int b = 0; b < m.num_blocks; b++) {
+        __m256i fail_v = _mm256_setzero_si256();
+        unsigned fail = 0;
+        for (int row = m.row_offsets[b]; row < m.row_offsets[b + 1] && fail != ALL_LANES; row++) {
+            __m256i res = _mm256_loadu_si256((const __m256i*)&m.resources[row * LANES]);
+            __m256i amt = _mm256_loadu_si256((const __m256i*)&m.amounts[row * LANES]);
+            __m256i st = _mm256_i32gather_epi32(stocks, res, 4);
+            fail_v = _mm256_or_si256(fail_v, _mm256_cmpgt_epi32(amt, st));
+            fail = _mm256_movemask_ps(_mm256_castsi256_ps(fail_v));
+        }
+        words[b >> 3] |= (uint64_t)(~fail & ALL_LANES) << ((b & 7) * LANES);
+    }
+}
+
+#else
+
+// Fuera de x86 bestIsa() siempre es SCALAR; estos solo existen para enlazar
+void RequirementMatrix::sse2Kernel(const RequirementMatrix& m, const int* stocks, uint64_t* words)
+{
+    scalarKernel(m, stocks, words);
+}
+
+void RequirementMatrix::avx2Kernel(const RequirementMatrix& m, const int* stocks, uint64_t* words)
+{
+    scalarKernel(m, stocks, words);
+}
+
+#endif
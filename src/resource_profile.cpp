@@ -0,0 +1,287 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   resource_profile.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:10:02 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 14:02:45 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/resource_profile.hpp"
+
+static const int NO_LIMIT = std::numeric_limits<int>::max();
+
+// Ciclos hasta que llega lo producido: lo de delay 0 termina en el ciclo en
+// que empieza pero sus productos no se pueden gastar hasta el siguiente,
+// igual que en el simulador y en Verifier::start
+static int arrivalLag(const Problem& problem, int proc)
+{
+    return std::max(problem.delays[proc], 1);
+}
+
+ResourceProfile::ResourceProfile(const Problem& problem)
+    : problem(problem), horizon(0), width(1), num_rows(0)
+{
+    row_of.assign(problem.numResources(), -1);
+    for (int r = 0; r < problem.numResources(); r++)
+        if (problem.numConsumers(r) > 0)
+            row_of[r] = num_rows++;
+}
+
+// ============================================================================
+// ÁRBOL DE SEGMENTOS DINÁMICO (suma en rango, mínimo en rango)
+// ============================================================================
+
+int ResourceProfile::newNode()
+{
+    nodes.push_back(Node{0, 0, -1, -1});
+    return nodes.size() - 1;
+}
+
+void ResourceProfile::update(int node, int l, int r, int a, int b, int delta)
+{
+    if (b <= l || r <= a)
+        return;
+    if (a <= l && r <= b) {
+        nodes[node].add += delta;
+        nodes[node].min += delta;
+        return;
+    }
+    // newNode puede reubicar el vector: nada de referencias a nodes aquí
+    if (nodes[node].left < 0) {
+        int child = newNode();
+        nodes[node].left = child;
+    }
+    if (nodes[node].right < 0) {
+        int child = newNode();
+        nodes[node].right = child;
+    }
+    int mid = l + (r - l) / 2;
+    update(nodes[node].left, l, mid, a, b, delta);
+    update(nodes[node].right, mid, r, a, b, delta);
+    nodes[node].min = nodes[node].add +
+        std::min(childMin(nodes[node].left), childMin(nodes[node].right));
+}
+
+// acc = suma de los add de los ancestros
+int ResourceProfile::queryMin(int node, int l, int r, int a, int b, int acc) const
+{
+    if (b <= l || r <= a)
+        return NO_LIMIT;
+    if (node < 0)
+        return acc;
+    if (a <= l && r <= b)
+        return acc + nodes[node].min;
+    int mid = l + (r - l) / 2;
+    acc += nodes[node].add;
+    return std::min(queryMin(nodes[node].left, l, mid, a, b, acc),
+                    queryMin(nodes[node].right, mid, r, a, b, acc));
+}
+
+// Último instante de [a, b) con nivel < q, -1 si no hay
+int ResourceProfile::lastBelow(int node, int l, int r, int a, int b, int q, int acc) const
+{
+    if (b <= l || r <= a)
+        return -1;
+    if (node < 0)
+        return acc < q ? std::min(r, b) - 1 : -1;
+    if (acc + nodes[node].min >= q)
+        return -1;
+    if (r - l == 1)
+        return l;
+    int mid = l + (r - l) / 2;
+    acc += nodes[node].add;
+    int found = lastBelow(nodes[node].right, mid, r, a, b, q, acc);
+    if (found >= 0)
+        return found;
+    return lastBelow(nodes[node].left, l, mid, a, b, q, acc);
+}
+
+// Primer instante de [a, b) con nivel < q, -1 si no hay
+int ResourceProfile::firstBelow(int node, int l, int r, int a, int b, int q, int acc) const
+{
+    if (b <= l || r <= a)
+        return -1;
+    if (node < 0)
+        return acc < q ? std::max(l, a) : -1;
+    if (acc + nodes[node].min >= q)
+        return -1;
+    if (r - l == 1)
+        return l;
+    int mid = l + (r - l) / 2;
+    acc += nodes[node].add;
+    int found = firstBelow(nodes[node].left, l, mid, a, b, q, acc);
+    if (found >= 0)
+        return found;
+    return firstBelow(nodes[node].right, mid, r, a, b, q, acc);
+}
+
+void ResourceProfile::addRange(int row, int from, int to, int delta)
+{
+    update(roots[row], 0, width, std::max(from, 0), std::min(to, width), delta);
+}
+
+int ResourceProfile::minRange(int row, int from, int to) const
+{
+    return queryMin(roots[row], 0, width, std::max(from, 0), std::min(to, width), 0);
+}
+
+// ============================================================================
+// PERFIL
+// ============================================================================
+
+void ResourceProfile::build(const std::vector<int>& initial_stocks,
+                            const std::vector<int>& procs,
+                            const std::vector<int>& starts,
+                            int horizon_param)
+{
+    horizon = std::max(0, horizon_param);
+    width = horizon + 1;
+    nodes.clear();
+    roots.assign(num_rows, -1);
+
+    for (int r = 0; r < problem.numResources(); r++) {
+        int row = row_of[r];
+        if (row < 0)
+            continue;
+        roots[row] = newNode();
+        nodes[roots[row]].add = initial_stocks[r];
+        nodes[roots[row]].min = initial_stocks[r];
+    }
+
+    for (size_t i = 0; i < procs.size(); i++)
+        addActivity(procs[i], starts[i], 1);
+}
+
+void ResourceProfile::addActivity(int proc, int start, int sign)
+{
+    int finish = start + arrivalLag(problem, proc);
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++)
+        addRange(row_of[problem.req_resources[k]], start, width,
+                 -sign * problem.req_amounts[k]);
+    for (int k = problem.prod_offsets[proc]; k < problem.prod_offsets[proc + 1]; k++) {
+        int row = row_of[problem.prod_resources[k]];
+        if (row >= 0)
+            addRange(row, finish, width, sign * problem.prod_amounts[k]);
+    }
+}
+
+bool ResourceProfile::feasible() const
+{
+    for (int root : roots)
+        if (nodes[root].min < 0)
+            return false;
+    return true;
+}
+
+bool ResourceProfile::canStartAt(int proc, int t) const
+{
+    if (t < 0 || t > horizon)
+        return false;
+    // Lo que produce llega más tarde y solo puede subir niveles
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++)
+        if (minRange(row_of[problem.req_resources[k]], t, width) < problem.req_amounts[k])
+            return false;
+    return true;
+}
+
+int ResourceProfile::earliestStart(int proc, int from) const
+{
+    int t = std::max(from, 0);
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++) {
+        int row = row_of[problem.req_resources[k]];
+        int last = lastBelow(roots[row], 0, width, 0, width, problem.req_amounts[k], 0);
+        t = std::max(t, last + 1);
+    }
+    return t <= horizon ? t : -1;
+}
+
+// Aplica (sign = 1) o deshace (sign = -1) el movimiento start -> new_start
+void ResourceProfile::shift(int proc, int start, int new_start, int sign)
+{
+    int lag = arrivalLag(problem, proc);
+    int finish = start + lag;
+    int new_finish = new_start + lag;
+
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++) {
+        int row = row_of[problem.req_resources[k]];
+        int q = problem.req_amounts[k] * sign;
+        if (new_start < start)
+            addRange(row, new_start, start, -q);
+        else
+            addRange(row, start, new_start, q);
+    }
+    for (int k = problem.prod_offsets[proc]; k < problem.prod_offsets[proc + 1]; k++) {
+        int row = row_of[problem.prod_resources[k]];
+        if (row < 0)
+            continue;
+        int q = problem.prod_amounts[k] * sign;
+        if (new_finish < finish)
+            addRange(row, new_finish, finish, q);
+        else
+            addRange(row, finish, new_finish, -q);
+    }
+}
+
+bool ResourceProfile::tryShift(int proc, int start, int new_start)
+{
+    int delay = problem.delays[proc];
+    if (new_start == start || new_start < 0 || new_start + delay > horizon)
+        return new_start == start;
+
+    shift(proc, start, new_start, 1);
+
+    // Solo pueden haber bajado los niveles dentro de las dos ventanas movidas
+    int lo_s = std::min(start, new_start), hi_s = std::max(start, new_start);
+    int lag = arrivalLag(problem, proc);
+    int lo_f = lo_s + lag, hi_f = hi_s + lag;
+    bool ok = true;
+    for (int k = problem.req_offsets[proc]; ok && k < problem.req_offsets[proc + 1]; k++) {
+        int row = row_of[problem.req_resources[k]];
+        ok = minRange(row, lo_s, hi_s) >= 0 && minRange(row, lo_f, hi_f) >= 0;
+    }
+    for (int k = problem.prod_offsets[proc]; ok && k < problem.prod_offsets[proc + 1]; k++) {
+        int row = row_of[problem.prod_resources[k]];
+        if (row >= 0)
+            ok = minRange(row, lo_s, hi_s) >= 0 && minRange(row, lo_f, hi_f) >= 0;
+    }
+
+    if (!ok)
+        shift(proc, start, new_start, -1);
+    return ok;
+}
+
+// Adelantar a t consume antes: cada requisito necesita nivel >= q en
+// [t, start). Lo producido también llega antes, así que basta con eso
+int ResourceProfile::earliestShift(int proc, int start) const
+{
+    int t = 0;
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++) {
+        int row = row_of[problem.req_resources[k]];
+        int last = lastBelow(roots[row], 0, width, 0, start, problem.req_amounts[k], 0);
+        t = std::max(t, last + 1);
+    }
+    return std::min(t, start);
+}
+
+// Retrasar el fin a f' quita lo producido en [finish, f'): cada producto
+// seguido necesita nivel >= q en esa ventana
+int ResourceProfile::latestShift(int proc, int start, int limit) const
+{
+    int lag = arrivalLag(problem, proc);
+    int finish = start + lag;
+    // El fin no pasa del límite; la llegada va lag - delay ciclos detrás
+    int latest = std::min(limit, horizon) + lag - problem.delays[proc];
+    for (int k = problem.prod_offsets[proc]; k < problem.prod_offsets[proc + 1]; k++) {
+        int row = row_of[problem.prod_resources[k]];
+        if (row < 0)
+            continue;
+        int first = firstBelow(roots[row], 0, width, finish, latest, problem.prod_amounts[k], 0);
+        if (first >= 0)
+            latest = std::min(latest, first);
+    }
+    return std::max(latest - lag, start);
+}
@@ -11,135 +11,311 @@
 /* ************************************************************************** */
 
 #include "../include/simulator.hpp"
+#include "../include/profiler.hpp"
 
-Simulator::Simulator(Parser P)
-	: time(0), stocks_now(P.getStocks()), process_pending(P.getAllProcesses()),
-	  info(P), target_quantity(100)
+Simulator::Simulator(const Problem& problem)
+	: problem(problem), time(0), record_history(true), trace(nullptr),
+	  stocks_now(problem.initial_stocks), running_count(0),
+	  event_count(0), instance_count(0),
+	  dirty_flag(problem.numProcesses(), 0), ready_heap(problem.numProcesses()), static_scores(problem.numProcesses(), 0),
+	  target_reached(false), target_stock(-1), target_quantity(100),
+	  objective_active(false), objective_open(0), feeding_running(0),
+	  fast_forward(true), ff_done(true), ff_stock_hash(0)
 {
+	for (int p = 0; p < problem.numProcesses(); p++)
+	{
+		process_pending.push_back(p);
+		markDirty(p);
+	}
+	history.reset(stocks_now);
+}
+
+bool Simulator::haveStocksFor(int proc) const
+{
+	return problem.hasStocksFor(proc, stocks_now);
+}
+
+void Simulator::substractStocks(int stock, int amount)
+{
+	int before = stocks_now[stock];
+	stocks_now[stock] -= amount;
+	if (!ff_done)
+		updateStockHash(stock, before);
+	if (record_history)
+		history.onChange(stock, -amount);
+	markConsumersDirty(stock);
+	if (stock == target_stock)
+		checkTarget();
+	if (objective_active && objective.slot(stock) >= 0)
+		onObjectiveChange(stock, before);
+}
+
+void Simulator::addStocks(int stock, int amount)
+{
+	// Saturar en vez de desbordar con lotes grandes
+	long long total = (long long)stocks_now[stock] + amount;
+	int before = stocks_now[stock];
+	stocks_now[stock] = (int)std::min<long long>(total, std::numeric_limits<int>::max());
+	if (!ff_done)
+		updateStockHash(stock, before);
+	if (record_history)
+		history.onChange(stock, stocks_now[stock] - before);
+	markConsumersDirty(stock);
+	if (stock == target_stock)
+		checkTarget();
+	if (objective_active && objective.slot(stock) >= 0)
+		onObjectiveChange(stock, before);
+}
+
+static uint64_t mixHash(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t stockKey(int resource, int amount)
+{
+    return mixHash(((uint64_t)(uint32_t)resource << 32) | (uint32_t)amount);
 }
 
-bool Simulator::haveStocksFor(Process to_do)
+// El único término del score que depende de los stocks: si cambia, se
+// recalcula la clave de todos los listos
+void Simulator::checkTarget()
 {
-	for (const auto &[resource, amount_needed] : to_do.requisites)
+	bool reached = stocks_now[target_stock] >= target_quantity;
+	if (reached == target_reached)
+		return;
+	target_reached = reached;
+	std::vector<int> ready = ready_heap.items();
+	for (int p : ready)
+		ready_heap.update(p, smart_score(p));
+
+	// Un objetivo que nadie consume ya no puede bajar: su valor deja de
+	// influir en las decisiones y sale del estado periódico
+	if (!ff_done && reached && problem.numConsumers(target_stock) == 0
+		&& ff_relevant[target_stock])
 	{
-		auto stock_it = stocks_now.find(resource);
-		if (stock_it != stocks_now.end())
-		{
-			if (stock_it->second - amount_needed < 0)
-				return false;
-		}
-		else
-		{
-			return false;
-		}
+		ff_stock_hash ^= stockKey(target_stock, stocks_now[target_stock]);
+		ff_relevant[target_stock] = 0;
+		ff_has_mark = false;
 	}
+}
+
+void Simulator::setObjective(const Objective& o)
+{
+	objective = o;
+	objective_active = o.hasResources();
+	if (!objective_active)
+		return;
+	target_stock = o.primary();
+	target_quantity = o.getBound(target_stock);
+}
+
+void Simulator::onObjectiveChange(int resource, int before)
+{
+	int bound = objective.getBound(resource);
+	objective_open += (before >= bound) - (stocks_now[resource] >= bound);
+}
+
+int Simulator::countOpenObjectives() const
+{
+	int open = 0;
+	for (int r : objective.getResources())
+		open += stocks_now[r] < objective.getBound(r);
+	return open;
+}
+
+// Se mira antes de los lanzamientos: el objetivo ya no puede mejorar si
+// todos sus recursos están en la cota, o si ningún lote en marcha lo
+// alimenta y ningún proceso listo para lanzarse tampoco
+bool Simulator::objectiveSettled()
+{
+	if (!objective_active)
+		return false;
+	if (objective_open == 0)
+		return true;
+	if (feeding_running > 0)
+		return false;
+	refreshReady();
+	for (int p : ready_heap.items())
+		if (objective.feedsObjective(p))
+			return false;
 	return true;
 }
 
-void Simulator::substractStocks(std::string stock, int amount)
+void Simulator::markDirty(int proc)
 {
-	auto stock_it = stocks_now.find(stock);
-	if (stock_it != stocks_now.end())
+	if (!dirty_flag[proc])
 	{
-		stock_it->second -= amount;
-	}
-	else
-	{
-		stocks_now[stock] = -amount;
+		dirty_flag[proc] = 1;
+		dirty_list.push_back(proc);
 	}
 }
 
-void Simulator::addStocks(std::string stock, int amount)
+void Simulator::markConsumersDirty(int resource)
 {
-	auto stock_it = stocks_now.find(stock);
-	if (stock_it != stocks_now.end())
-	{
-		stock_it->second += amount;
-	}
-	else
+	for (int k = problem.consumer_offsets[resource]; k < problem.consumer_offsets[resource + 1]; k++)
+		markDirty(problem.consumer_procs[k]);
+}
+
+// Revisa solo los procesos sucios y actualiza el conjunto de listos
+void Simulator::refreshReady()
+{
+	for (int p : dirty_list)
 	{
-		stocks_now[stock] = amount;
+		dirty_flag[p] = 0;
+		bool ready = haveStocksFor(p);
+		if (ready && !ready_heap.contains(p))
+			ready_heap.push(p, smart_score(p));
+		else if (!ready && ready_heap.contains(p))
+			ready_heap.erase(p);
 	}
+	dirty_list.clear();
 }
 
-bool Simulator::start_execution(const Process &to_do)
+// Lanza de golpe todas las instancias de proc que permiten los stocks.
+// Devuelve cuántas se lanzaron (0 si no había stock)
+int Simulator::start_execution(int proc)
 {
-	if (!haveStocksFor(to_do))
-		return false;
+	int count = problem.maxRuns(proc, stocks_now);
+	if (count == 0)
+		return 0;
 
 	// Restar stocks
-	for (const auto &[resource, amount_needed] : to_do.requisites)
-		substractStocks(resource, amount_needed);
+	for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++)
+		substractStocks(problem.req_resources[k], problem.req_amounts[k] * count);
 
-	// Ejecutar
-	process_executing.push_back(exec_process{to_do, time});
-	return true;
+	// Ejecutar: reutilizar un hueco libre si lo hay
+	int handle;
+	if (!free_handles.empty())
+	{
+		handle = free_handles.back();
+		free_handles.pop_back();
+		process_executing[handle] = exec_process{proc, time, count};
+	}
+	else
+	{
+		handle = process_executing.size();
+		process_executing.push_back(exec_process{proc, time, count});
+	}
+	events.push(completion_event{time + problem.delays[proc], handle});
+	running_count++;
+	event_count++;
+	instance_count += count;
+	if (objective_active && objective.feedsObjective(proc))
+		feeding_running++;
+	if (!ff_done)
+		ff_starts.push_back(period_start{time, proc, count});
+
+	if (trace)
+		trace->write(time, problem.process_names[proc], count);
+	return count;
 }
 
-void Simulator::end_execution(std::string process_n)
+void Simulator::end_execution(int handle)
 {
-	auto it = std::find_if(process_executing.begin(), process_executing.end(),
-						   [&](const exec_process &e)
-						   { return e.proc.name == process_n; });
+	exec_process &e = process_executing[handle];
+	if (e.proc < 0)
+		return;
 
-	if (it != process_executing.end())
+	for (int k = problem.prod_offsets[e.proc]; k < problem.prod_offsets[e.proc + 1]; k++)
 	{
-		for (auto &st : it->proc.produces)
-			addStocks(st.first, st.second);
-		history.push_back(execution{it->start, time, it->proc.name, stocks_now});
-		process_executing.erase(it);
+		long long amount = (long long)problem.prod_amounts[k] * e.count;
+		addStocks(problem.prod_resources[k],
+			(int)std::min<long long>(amount, std::numeric_limits<int>::max()));
 	}
+	if (record_history)
+		history.record(execution{e.start, time, e.proc, e.count}, time);
+	if (objective_active && objective.feedsObjective(e.proc))
+		feeding_running--;
+
+	e.proc = -1;
+	free_handles.push_back(handle);
+	running_count--;
+	event_count++;
 }
 
-void Simulator::simulate()
+// Análisis del objetivo y parte estática de los scores
+void Simulator::prepareScores()
 {
-    time = 0;
-    max_cycles = 10000;
-	liquidation_mode = false;
-    // Análisis inicial si hay objetivo
-    if (!target_stock.empty()) {
+    if (target_stock >= 0) {
         dep_graph.analyze_full_chain(
             target_stock,
             target_quantity,
             stocks_now,
-            info.getAllProcesses()
+            problem
         );
     }
+    computeStaticScores();
+    if (target_stock >= 0)
+        target_reached = stocks_now[target_stock] >= target_quantity;
+}
+
+void Simulator::simulate()
+{
+    time = 0;
+    max_cycles = 10000;
+	liquidation_mode = false;
+    prepareScores();
+    initSteadyState();
+    if (objective_active)
+        objective_open = countOpenObjectives();
     
+    // Dirigido por eventos: entre dos finalizaciones los stocks no cambian,
+    // así que el tiempo salta directamente al siguiente evento
+    bool settled = false;
     while(1)
     {
         checkRunningProcs();
         
-        std::vector<Process> can_execute;
+        // Objetivo que ya no puede mejorar: no se lanza nada más y lo que
+        // está en marcha termina, así los stocks finales incluyen lo que
+        // produce
+        if (!settled)
+            settled = objectiveSettled();
         
-        can_execute = executableProcesses_Smart();
-        
-        for (auto& p : can_execute)
-            start_execution(p);
+        // Una sola pasada en orden de score: cada proceso lanza de golpe
+        // todas las instancias que le dejan los stocks, así que después
+        // no queda nada ejecutable hasta el siguiente evento
+        if (!settled)
+        {
+            std::vector<int> can_execute = executableProcesses_Smart();
+            for (int p : can_execute)
+                start_execution(p);
+        }
+        if (record_history)
+            history.seal(time);
         
         // Parar si no hay nada que hacer
-        if (can_execute.empty() && process_executing.empty())
+        if (running_count == 0)
             break;
         
         // Parar si alcanzamos el límite de ciclos
         if (time >= max_cycles)
             break;
         
+        if (!ff_done && !settled)
+            observeSteadyState();
+        
 		// if (time >= max_cycles * 0.8)
         //     liquidation_mode = true;
 		
-        time++;
+        // Siempre al menos un ciclo: un lote de delay 0 termina en el mismo
+        // ciclo en que empieza y sus productos llegan en el siguiente, como
+        // en el bucle ciclo a ciclo
+        time = std::max(time + 1, std::min(events.top().finish, max_cycles));
     }
 }
 
 void Simulator::checkRunningProcs()
 {
-	for (int i = process_executing.size() - 1; i >= 0; --i)
+	PROFILE_SCOPE(PROF_CHECK_RUNNING);
+	while (!events.empty() && events.top().finish <= this->time)
 	{
-		if (this->time == (process_executing[i].proc.delay + process_executing[i].start))
-		{
-			end_execution(process_executing[i].proc.name);
-		}
+		int handle = events.top().handle;
+		events.pop();
+		end_execution(handle);
 	}
 }
 
@@ -151,39 +327,61 @@ void Simulator::checkRunningProcs()
 // 	return false;
 // }
 
-std::vector<Process> Simulator::executableProcesses_Smart()
+std::vector<int> Simulator::executableProcesses_Smart()
 {
-    std::vector<Process> executable;
+    PROFILE_SCOPE(PROF_EXECUTABLE_SMART);
+    refreshReady();
     
-    for (auto& p : process_pending) {
-        if (haveStocksFor(p))
-			// if (liquidation_mode && !needsTarget(p, target_stock))
-            executable.push_back(p);
+    // Sacar los listos en orden de score (a igualdad, por id). Se vuelven a
+    // marcar sucios para que la siguiente revisión los reinserte si procede
+    std::vector<int> executable;
+    executable.reserve(ready_heap.size());
+    while (!ready_heap.empty()) {
+        int p = ready_heap.top();
+        ready_heap.pop();
+        markDirty(p);
+        executable.push_back(p);
     }
     
-    // Ordenar por score
-    std::sort(executable.begin(), executable.end(),
-        [&](const Process& a, const Process& b) {
-            return smart_score(a) > smart_score(b);
-        });
-    
     return executable;
 }
 
-int Simulator::smart_score(const Process& p) {
+void Simulator::computeStaticScores()
+{
+    for (int p = 0; p < problem.numProcesses(); p++)
+        static_scores[p] = static_score(p);
+}
+
+int Simulator::smart_score(int p) const {
+    PROFILE_SCOPE(PROF_SMART_SCORE);
+    return adjustedScore(static_scores[p], target_reached);
+}
+
+int Simulator::adjustedScore(int static_score, bool reached)
+{
+    // 6. Objetivo alcanzado
+    if (reached)
+        return static_score / 10;
+    return static_score;
+}
+
+// Parte del score que no depende del ciclo: solo consulta dep_graph
+int Simulator::static_score(int p) {
     int score = 0;
     
     // 1. CRÍTICO: ¿El proceso está en el camino crítico?
-    if (dep_graph.is_process_critical(p.name)) {
+    if (dep_graph.is_process_critical(p)) {
         score += 20000;  // MÁXIMA PRIORIDAD ABSOLUTA
     }
     
     // 2. Holgura del proceso (slack)
-    int slack = dep_graph.get_process_slack(p.name);
+    int slack = dep_graph.get_process_slack(p);
     score += (1000 - slack * 10);  // Menos holgura = más urgente
     
     // 3. Score por lo que PRODUCE
-    for (auto& [resource, qty] : p.produces) {
+    for (int k = problem.prod_offsets[p]; k < problem.prod_offsets[p + 1]; k++) {
+        int resource = problem.prod_resources[k];
+        int qty = problem.prod_amounts[k];
         // Prioridad base del recurso
         int resource_priority = dep_graph.get_resource_priority(resource);
         score += resource_priority * qty;
@@ -215,13 +413,15 @@ int Simulator::smart_score(const Process& p) {
     }
     
     // 4. Penalización por lo que CONSUME
-    for (auto& [resource, qty] : p.requisites) {
+    for (int k = problem.req_offsets[p]; k < problem.req_offsets[p + 1]; k++) {
+        int resource = problem.req_resources[k];
+        int qty = problem.req_amounts[k];
         // No consumir recursos críticos salvo que sea necesario
         if (dep_graph.is_on_critical_path(resource)) {
             // Si lo que produce TAMBIÉN es crítico, ok
             bool produces_critical = false;
-            for (auto& [prod, qty] : p.produces) {
-                if (dep_graph.is_on_critical_path(prod)) {
+            for (int j = problem.prod_offsets[p]; j < problem.prod_offsets[p + 1]; j++) {
+                if (dep_graph.is_on_critical_path(problem.prod_resources[j])) {
                     produces_critical = true;
                     break;
                 }
@@ -246,15 +446,188 @@ int Simulator::smart_score(const Process& p) {
     // 5. Delay del proceso
     // Procesos rápidos son mejores, pero si están en camino crítico
     // el delay ya está considerado
-    if (!dep_graph.is_process_critical(p.name)) {
-        score -= p.delay * 10;
-    }
-    
-    // 6. Objetivo alcanzado
-    if (!target_stock.empty() && 
-        stocks_now[target_stock] >= target_quantity) {
-        score = score / 10;
+    if (!dep_graph.is_process_critical(p)) {
+        score -= problem.delays[p] * 10;
     }
     
     return score;
 }
+
+// ============================================================================
+// RÉGIMEN PERIÓDICO
+// ============================================================================
+//
+// Las decisiones solo dependen de los stocks de recursos que algún proceso
+// consume (elegibilidad y maxRuns), del objetivo (target_reached) y de qué
+// lotes siguen en marcha y cuánto les falta. Los recursos que nadie consume
+// solo acumulan: no cuentan para el estado y al saltar reciben k veces lo
+// que ganaron en un periodo.
+
+void Simulator::initSteadyState()
+{
+    // Con historial habría que repetir también sus frames: no se salta
+    ff_done = !fast_forward || record_history;
+    ff_starts.clear();
+    ff_has_mark = false;
+    ff_power = 1;
+    ff_lambda = 0;
+    if (ff_done)
+        return;
+
+    ff_relevant.assign(problem.numResources(), 0);
+    ff_stock_hash = 0;
+    for (int r = 0; r < problem.numResources(); r++) {
+        ff_relevant[r] = problem.numConsumers(r) > 0 || r == target_stock;
+        if (ff_relevant[r])
+            ff_stock_hash ^= stockKey(r, stocks_now[r]);
+    }
+}
+
+void Simulator::updateStockHash(int resource, int before)
+{
+    if (ff_relevant[resource])
+        ff_stock_hash ^= stockKey(resource, before) ^ stockKey(resource, stocks_now[resource]);
+}
+
+// Los lotes se combinan con suma: no importa en qué hueco esté cada uno
+uint64_t Simulator::stateHash() const
+{
+    uint64_t h = ff_stock_hash ^ (target_reached ? 0x9E3779B97F4A7C15ULL : 0);
+    uint64_t running = 0;
+    for (const exec_process& e : process_executing) {
+        if (e.proc < 0)
+            continue;
+        int remaining = e.start + problem.delays[e.proc] - time;
+        running += mixHash(((uint64_t)(uint32_t)e.proc << 32 | (uint32_t)remaining)
+                           ^ ((uint64_t)(uint32_t)e.count * 0xD1B54A32D192ED03ULL));
+    }
+    return h ^ mixHash(running);
+}
+
+// Estado exacto para confirmar una coincidencia de hash
+void Simulator::buildSignature(std::vector<int>& out) const
+{
+    out.clear();
+    out.push_back(target_reached);
+    for (int r = 0; r < problem.numResources(); r++)
+        if (ff_relevant[r])
+            out.push_back(stocks_now[r]);
+
+    size_t first = out.size();
+    for (const exec_process& e : process_executing) {
+        if (e.proc < 0)
+            continue;
+        out.push_back(e.start + problem.delays[e.proc] - time);
+        out.push_back(e.proc);
+        out.push_back(e.count);
+    }
+    // Ordenar los lotes como tripletas
+    size_t n = (out.size() - first) / 3;
+    std::vector<int> order(n);
+    for (size_t i = 0; i < n; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return std::lexicographical_compare(
+            out.begin() + first + 3 * a, out.begin() + first + 3 * a + 3,
+            out.begin() + first + 3 * b, out.begin() + first + 3 * b + 3);
+    });
+    std::vector<int> sorted(out.begin() + first, out.end());
+    for (size_t i = 0; i < n; i++)
+        std::copy(sorted.begin() + 3 * order[i], sorted.begin() + 3 * order[i] + 3,
+                  out.begin() + first + 3 * i);
+}
+
+// Se llama tras los lanzamientos de cada punto de decisión
+void Simulator::observeSteadyState()
+{
+    // Un periodo necesita que el tiempo haya avanzado desde la marca
+    if (ff_has_mark && time <= ff_mark_time)
+        return;
+
+    uint64_t h = stateHash();
+
+    if (ff_has_mark && h == ff_mark_hash) {
+        buildSignature(ff_signature);
+        if (ff_signature == ff_mark_signature) {
+            fastForwardPeriods(time - ff_mark_time);
+            ff_done = true;
+            ff_starts.clear();
+            return;
+        }
+    }
+
+    if (!ff_has_mark || ff_power == ff_lambda) {
+        ff_power = ff_has_mark ? ff_power * 2 : 1;
+        ff_lambda = 0;
+        ff_has_mark = true;
+        ff_mark_hash = h;
+        ff_mark_time = time;
+        buildSignature(ff_mark_signature);
+        ff_mark_stocks = stocks_now;
+        ff_mark_events = event_count;
+        ff_mark_instances = instance_count;
+        ff_starts.clear();
+    }
+    ff_lambda++;
+}
+
+// El estado en time es el de ff_mark_time desplazado period ciclos: se
+// avanzan tantos periodos enteros como quepan antes de max_cycles, sin
+// llegar a él. La simulación normal sigue desde ahí y hace el tramo final,
+// incluido el paso de al menos un ciclo que viene justo después del salto
+void Simulator::fastForwardPeriods(int period)
+{
+    if (period <= 0)
+        return;
+    long long k = ((long long)max_cycles - time - 1) / period;
+    // Sin pasar de largo la cota de un objetivo: el cruce lo hace la
+    // simulación normal, que es la que para en el ciclo exacto
+    if (objective_active) {
+        for (int r : objective.getResources()) {
+            long long delta = (long long)stocks_now[r] - ff_mark_stocks[r];
+            int bound = objective.getBound(r);
+            if (delta > 0 && stocks_now[r] < bound)
+                k = std::min(k, ((long long)bound - 1 - stocks_now[r]) / delta);
+        }
+    }
+    if (k <= 0)
+        return;
+    long long shift = k * period;
+
+    // Traza de los periodos saltados, en el mismo orden que una ejecución
+    // completa
+    if (trace) {
+        for (long long j = 1; j <= k; j++)
+            for (const period_start& s : ff_starts)
+                trace->write(s.time + j * period, problem.process_names[s.proc], s.count);
+    }
+
+    // Stocks: los relevantes no cambian en un periodo; el resto acumula
+    for (int r = 0; r < problem.numResources(); r++) {
+        long long delta = (long long)stocks_now[r] - ff_mark_stocks[r];
+        if (delta == 0)
+            continue;
+        long long total = stocks_now[r] + k * delta;
+        stocks_now[r] = (int)std::max<long long>(std::numeric_limits<int>::min(),
+            std::min<long long>(total, std::numeric_limits<int>::max()));
+    }
+    if (objective_active)
+        objective_open = countOpenObjectives();
+    event_count += k * (event_count - ff_mark_events);
+    instance_count += k * (instance_count - ff_mark_instances);
+
+    // Lotes en marcha y eventos, desplazados
+    for (exec_process& e : process_executing)
+        if (e.proc >= 0)
+            e.start += shift;
+    std::vector<completion_event> pending;
+    while (!events.empty()) {
+        completion_event ev = events.top();
+        events.pop();
+        ev.finish += shift;
+        pending.push_back(ev);
+    }
+    for (const completion_event& ev : pending)
+        events.push(ev);
+    time += shift;
+}
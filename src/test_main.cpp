@@ -0,0 +1,331 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_main.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 21:14:37 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 21:14:37 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/generator.hpp"
+#include "../include/mapped_parser.hpp"
+#include "../include/simulator.hpp"
+#include "../include/problem_cache.hpp"
+#include "../include/lp_bound.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+// ============================================================================
+// PRUEBAS DE COMPONENTES
+// ============================================================================
+//
+// Comprobaciones de las piezas que tests/run.sh no ve desde fuera: cada
+// grupo contrasta un componente con una referencia ingenua. Sale con 1 si
+// falla alguna.
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what)
+{
+    if (!ok) {
+        std::cout << "FALLO " << what << "\n";
+        failures++;
+    }
+}
+
+static void report(const char* group, int failures_before)
+{
+    if (failures == failures_before)
+        std::cout << "ok    " << group << "\n";
+}
+
+// ============================================================================
+// HISTORY: RECONSTRUCCIÓN CONTRA UNA REPETICIÓN COMPLETA
+// ============================================================================
+
+// Alimenta History igual que el simulador (finalizaciones con record, luego
+// lanzamientos y seal) durante varios intervalos de checkpoint, guardando
+// aparte el estado completo de cada ciclo y de cada finalización
+static void testHistoryReplay()
+{
+    const int num_resources = 7;
+    const int cycles = 3 * History::CHECKPOINT_EVERY + 37;
+    Rng rng(2026);
+
+    std::vector<int> state(num_resources);
+    for (int r = 0; r < num_resources; r++)
+        state[r] = rng.below(50);
+    History history;
+    history.reset(state);
+    const std::vector<int> initial = state;
+
+    std::vector<std::vector<int> > at_cycle;    // estado al cerrar cada ciclo
+    std::vector<std::vector<int> > at_entry;    // estado tras cada record
+    auto change = [&](int resource, int delta) {
+        state[resource] += delta;
+        history.onChange(resource, delta);
+    };
+
+    for (int t = 0; t < cycles; t++) {
+        // Finalizaciones: una puede no cambiar nada y otra dejar un delta
+        // neto cero en un recurso
+        int completions = rng.below(4);
+        for (int c = 0; c < completions; c++) {
+            int changes = rng.below(3);
+            for (int k = 0; k < changes; k++)
+                change(rng.below(num_resources), rng.below(9) - 4);
+            if (rng.below(5) == 0) {
+                int r = rng.below(num_resources);
+                change(r, 3);
+                change(r, -3);
+            }
+            history.record(execution{t - 1, t, c, 1}, t);
+            at_entry.push_back(state);
+        }
+        // Lanzamientos; hay ciclos sin ningún cambio
+        int launches = rng.below(3);
+        for (int k = 0; k < launches; k++)
+            change(rng.below(num_resources), -rng.below(4));
+        history.seal(t);
+        at_cycle.push_back(state);
+    }
+
+    check(history.size() == at_entry.size(), "history: número de finalizaciones");
+    for (int t = 0; t < cycles; t++)
+        check(history.stocksAt(t) == at_cycle[t], "history: stocksAt(" + std::to_string(t) + ")");
+    check(history.stocksAt(-1) == initial, "history: stocksAt antes del primer ciclo");
+    check(history.stocksAt(cycles + 10) == at_cycle.back(), "history: stocksAt después del último ciclo");
+
+    // Acceso aleatorio y recorrido con el iterador (que reutiliza su estado)
+    size_t i = 0;
+    for (auto it = history.begin(); it != history.end(); ++it, i++) {
+        check(history.snapshot(i) == at_entry[i], "history: snapshot(" + std::to_string(i) + ")");
+        check(it.snapshot() == at_entry[i], "history: iterador en " + std::to_string(i));
+    }
+}
+
+// Con historial el simulador no salta periodos: el estado del último ciclo
+// tiene que ser el stock final, y cada snapshot el de su finalización
+static void testHistorySimulation()
+{
+    InstanceParams params;
+    params.family = CYCLIC;
+    params.size = 6;
+    Problem problem;
+    MappedParser(problem).parseBuffer(InstanceGenerator(params).generate());
+
+    Simulator sim(problem);
+    sim.setRecordHistory(true);
+    sim.simulate();
+    const History& history = sim.getHistory();
+
+    check(history.size() > 4 * History::CHECKPOINT_EVERY,
+          "history: la simulación cruza varios checkpoints");
+    check(history.stocksAt(sim.getCurrentTime()) == sim.getStockVector(),
+          "history: stocksAt del último ciclo = stocks finales");
+    size_t i = 0;
+    for (auto it = history.begin(); it != history.end(); ++it, i++)
+        if (it.snapshot() != history.snapshot(i)) {
+            check(false, "history: iterador y snapshot(" + std::to_string(i) + ") difieren");
+            break;
+        }
+}
+
+// ============================================================================
+// PROBLEMCACHE: IDA Y VUELTA Y CACHÉ OBSOLETA
+// ============================================================================
+
+static const char* CACHE_SOURCE =
+    "planche:7\n"
+    "do_montant:(planche:1):(montant:1):15\n"
+    "do_fond:(planche:2):(fond:1):20\n"
+    "do_etagere:(planche:1):(etagere:1):10\n"
+    "do_armoire_ikea:(montant:2;fond:1;etagere:3):(armoire:1):30\n"
+    "optimize:(time;armoire)\n";
+
+static bool sameProblem(const Problem& a, const Problem& b)
+{
+    if (a.resource_names != b.resource_names || a.process_names != b.process_names
+        || a.initial_stocks != b.initial_stocks || a.delays != b.delays
+        || a.req_offsets != b.req_offsets || a.req_resources != b.req_resources
+        || a.req_amounts != b.req_amounts || a.prod_offsets != b.prod_offsets
+        || a.prod_resources != b.prod_resources || a.prod_amounts != b.prod_amounts
+        || a.consumer_offsets != b.consumer_offsets || a.consumer_procs != b.consumer_procs
+        || a.producer_offsets != b.producer_offsets || a.producer_procs != b.producer_procs
+        || a.optimizations != b.optimizations)
+        return false;
+    // Las tablas de nombres se rehacen al cargar: tienen que resolver igual
+    for (int r = 0; r < a.numResources(); r++)
+        if (b.resourceId(a.resource_names[r]) != r)
+            return false;
+    for (int p = 0; p < a.numProcesses(); p++)
+        if (b.processId(a.process_names[p]) != p)
+            return false;
+    return true;
+}
+
+static std::string tempPath()
+{
+    char path[] = "/tmp/krpsim_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0)
+        close(fd);
+    return path;
+}
+
+static void testCacheRoundTrip(const std::string& path)
+{
+    std::string source = CACHE_SOURCE;
+    Problem parsed;
+    MappedParser(parsed).parseBuffer(source);
+    uint64_t hash = ProblemCache::hashSource(source);
+
+    check(ProblemCache::write(path, parsed, hash), "cache: escritura");
+    check(ProblemCache::isCache(path), "cache: firma");
+    Problem loaded;
+    check(ProblemCache::load(path, loaded, hash), "cache: carga con el hash del origen");
+    check(sameProblem(parsed, loaded), "cache: el problema cargado es el parseado");
+    Problem any;
+    check(ProblemCache::load(path, any), "cache: carga sin comprobar el origen");
+    check(sameProblem(parsed, any), "cache: ídem sin comprobar el origen");
+}
+
+// Un origen editado tiene otro hash: la caché se rechaza y no deja nada a
+// medias en el problema de salida. Una caché truncada tampoco se acepta
+static void testCacheStale(const std::string& path)
+{
+    std::string source = CACHE_SOURCE;
+    Problem parsed;
+    MappedParser(parsed).parseBuffer(source);
+    ProblemCache::write(path, parsed, ProblemCache::hashSource(source));
+
+    std::string edited = source;
+    edited.replace(edited.find(":15"), 3, ":16");
+    uint64_t edited_hash = ProblemCache::hashSource(edited);
+    check(edited_hash != ProblemCache::hashSource(source), "cache: el hash cambia con el origen");
+    Problem stale;
+    MappedParser(stale).parseBuffer(source);
+    check(!ProblemCache::load(path, stale, edited_hash), "cache: obsoleta rechazada");
+    check(stale.numResources() == 0 && stale.numProcesses() == 0,
+          "cache: obsoleta deja el problema vacío");
+
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() - 5);
+    Problem truncated;
+    check(!ProblemCache::load(path, truncated), "cache: truncada rechazada");
+    check(!ProblemCache::isCache("/dev/null"), "cache: un fichero vacío no es caché");
+}
+
+// ============================================================================
+// COTA LP: ÓPTIMOS CONOCIDOS
+// ============================================================================
+
+static bool near(double a, double b)
+{
+    return std::fabs(a - b) < 1e-6;
+}
+
+static Problem parseText(const std::string& text)
+{
+    Problem problem;
+    MappedParser(problem).parseBuffer(text);
+    return problem;
+}
+
+// Ejemplo de libro: max 3x + 5y con x <= 4, 2y <= 12, 3x + 2y <= 18.
+// Óptimo 36 en (2, 6), precios sombra (0, 3/2, 1)
+static void testSimplex()
+{
+    SimplexLP lp(2);
+    lp.setObjective(0, 3);
+    lp.setObjective(1, 5);
+    int r0 = lp.addConstraint({{0, 1.0}}, 4);
+    int r1 = lp.addConstraint({{1, 2.0}}, 12);
+    int r2 = lp.addConstraint({{0, 3.0}, {1, 2.0}}, 18);
+
+    check(lp.solve(100) == SimplexLP::OPTIMAL, "lp: simplex óptimo");
+    check(near(lp.value(), 36), "lp: valor del simplex");
+    check(near(lp.primal(0), 2) && near(lp.primal(1), 6), "lp: solución primal");
+    check(near(lp.dual(r0), 0) && near(lp.dual(r1), 1.5) && near(lp.dual(r2), 1),
+          "lp: precios sombra");
+    check(near(lp.slack(r0), 2) && near(lp.slack(r2), 0), "lp: holguras");
+
+    SimplexLP open(1);
+    open.setObjective(0, 1);
+    open.addConstraint({{0, -1.0}}, 1);
+    check(open.solve(100) == SimplexLP::UNBOUNDED, "lp: simplex no acotado");
+}
+
+static void testThroughputBound()
+{
+    // Las 7 planchas dan justo para un armario: todas las rutas limitan
+    Problem ikea = parseText(CACHE_SOURCE);
+    ThroughputResult r = ThroughputBound(ikea).compute(ikea.resourceId("armoire"));
+    check(r.status == ThroughputResult::BOUNDED, "lp: ikea acotado");
+    check(near(r.max_stock, 1) && r.stockBound() == 1, "lp: ikea cota 1 armario");
+    check(near(r.shadow_prices[ikea.resourceId("planche")], 1.0 / 7),
+          "lp: ikea precio sombra de planche");
+    check(!r.binding.empty() && r.binding.front() == ikea.resourceId("fond"),
+          "lp: ikea fond es el recurso más caro");
+
+    // Con 10 de a, p2 rinde 2/3 de t por unidad frente a 1/2 de p1: la
+    // cota fraccionaria es 20/3 y la entera 6
+    Problem two = parseText("a:10\n"
+                            "p1:(a:2):(t:1):1\n"
+                            "p2:(a:3):(t:2):1\n"
+                            "optimize:(t)\n");
+    r = ThroughputBound(two).compute(two.resourceId("t"));
+    check(r.status == ThroughputResult::BOUNDED, "lp: dos rutas acotado");
+    check(near(r.max_stock, 20.0 / 3) && r.stockBound() == 6, "lp: dos rutas cota 20/3");
+    check(near(r.runs[two.processId("p2")], 10.0 / 3) && near(r.runs[two.processId("p1")], 0),
+          "lp: dos rutas solo usa p2");
+    check(near(r.shadow_prices[two.resourceId("a")], 2.0 / 3), "lp: dos rutas precio de a");
+
+    // El horizonte deja fuera la ruta lenta aunque rinda más
+    Problem slow = parseText("a:10\n"
+                             "fast:(a:2):(t:1):1\n"
+                             "slow:(a:1):(t:1):10\n"
+                             "optimize:(t)\n");
+    int t = slow.resourceId("t");
+    check(near(ThroughputBound(slow).compute(t).max_stock, 10), "lp: horizonte amplio");
+    check(near(ThroughputBound(slow, 5).compute(t).max_stock, 5), "lp: horizonte corto");
+
+    // Un ciclo que duplica a no tiene cota
+    Problem loop = parseText("a:1\n"
+                             "grow:(a:1):(a:2):1\n"
+                             "sell:(a:1):(b:1):1\n"
+                             "optimize:(b)\n");
+    r = ThroughputBound(loop).compute(loop.resourceId("b"));
+    check(r.status == ThroughputResult::UNBOUNDED, "lp: ciclo de ganancia no acotado");
+}
+
+int main()
+{
+    int before = failures;
+    testHistoryReplay();
+    testHistorySimulation();
+    report("history", before);
+
+    before = failures;
+    std::string cache_path = tempPath();
+    testCacheRoundTrip(cache_path);
+    testCacheStale(cache_path);
+    std::remove(cache_path.c_str());
+    report("cache", before);
+
+    before = failures;
+    testSimplex();
+    testThroughputBound();
+    report("lp", before);
+
+    return failures == 0 ? 0 : 1;
+}
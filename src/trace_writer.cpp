@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_writer.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:40:52 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 15:40:52 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/trace_writer.hpp"
+#include <charconv>
+#include <cstring>
+
+TraceWriter::TraceWriter(FILE *out)
+	: out(out), owns(false), buffer(BUFFER_SIZE), used(0), lines(0)
+{
+}
+
+TraceWriter::~TraceWriter()
+{
+	flush();
+	if (owns)
+		fclose(out);
+}
+
+bool TraceWriter::open(const std::string &path)
+{
+	FILE *f = fopen(path.c_str(), "w");
+	if (!f)
+		return false;
+	flush();
+	if (owns)
+		fclose(out);
+	out = f;
+	owns = true;
+	return true;
+}
+
+void TraceWriter::flush()
+{
+	if (used > 0)
+		fwrite(buffer.data(), 1, used, out);
+	used = 0;
+	fflush(out);
+}
+
+void TraceWriter::write(int cycle, const std::string &name, int count)
+{
+	// Formatear la línea una vez y copiarla count veces
+	char prefix[16];
+	char *end = std::to_chars(prefix, prefix + sizeof(prefix), cycle).ptr;
+	size_t prefix_len = end - prefix;
+	size_t line_len = prefix_len + 1 + name.size() + 1;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (used + line_len > buffer.size())
+		{
+			fwrite(buffer.data(), 1, used, out);
+			used = 0;
+			// Línea más grande que el buffer: directa
+			if (line_len > buffer.size())
+			{
+				fwrite(prefix, 1, prefix_len, out);
+				fputc(':', out);
+				fwrite(name.data(), 1, name.size(), out);
+				fputc('\n', out);
+				lines++;
+				continue;
+			}
+		}
+		char *dst = buffer.data() + used;
+		memcpy(dst, prefix, prefix_len);
+		dst[prefix_len] = ':';
+		memcpy(dst + prefix_len + 1, name.data(), name.size());
+		dst[line_len - 1] = '\n';
+		used += line_len;
+		lines++;
+	}
+}
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verif_main.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:20:41 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 17:20:41 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/verifier.hpp"
+#include "../include/mapped_file.hpp"
+#include "../include/mapped_parser.hpp"
+#include "../include/problem_cache.hpp"
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cout << "Usage: ./krpsim_verif \"file\" \"trace\"\n";
+        return 1;
+    }
+    std::string file = argv[1];
+    std::string trace_path = argv[2];
+
+    // La config puede ser también una caché de --compile
+    Problem problem;
+    bool loaded;
+    if (ProblemCache::isCache(file))
+        loaded = ProblemCache::load(file, problem);
+    else
+        loaded = MappedParser(problem).parse(file);
+    if (!loaded)
+    {
+        std::cerr << "No se puede leer " << file << "\n";
+        return 1;
+    }
+
+    MappedFile trace;
+    if (!trace.open(trace_path))
+    {
+        std::cerr << "No se puede leer " << trace_path << "\n";
+        return 1;
+    }
+
+    Verifier verifier(problem);
+    bool ok = verifier.run(trace.view());
+
+    if (ok)
+        std::cout << "Traza correcta: " << verifier.getLines() << " lanzamientos\n";
+    else
+        std::cout << "Error en la línea " << verifier.getErrorLine() << ": "
+                  << verifier.getError() << "\n";
+
+    // Stocks en el momento del error o al terminar todo
+    std::map<std::string, long long> named;
+    for (int r = 0; r < problem.numResources(); r++)
+        named[problem.resource_names[r]] = verifier.getStocks()[r];
+    if (ok)
+        std::cout << "Tiempo final: " << verifier.getEndTime() << "\n";
+    else
+        std::cout << "Ciclo: " << verifier.getCycle() << "\n";
+    std::cout << (ok ? "Stocks finales:\n" : "Stocks en ese momento:\n");
+    for (const auto &kv : named)
+        std::cout << "  " << kv.first << ": " << kv.second << "\n";
+
+    return ok ? 0 : 1;
+}
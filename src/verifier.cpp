@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   verifier.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: jainavas <jainavas@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:20:41 by jainavas          #+#    #+#             */
+/*   Updated: 2026/10/18 17:20:41 by jainavas         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/verifier.hpp"
+#include <charconv>
+#include <cstring>
+
+Verifier::Verifier(const Problem& problem)
+    : problem(problem), cycle(0), end_time(0), lines(0), error_line(0)
+{
+    stocks.assign(problem.initial_stocks.begin(), problem.initial_stocks.end());
+}
+
+bool Verifier::fail(size_t line_no, const std::string& message)
+{
+    error_line = line_no;
+    error = message;
+    return false;
+}
+
+void Verifier::completeUntil(long long t)
+{
+    while (!events.empty() && events.top().arrival <= t) {
+        Completion c = events.top();
+        events.pop();
+        for (int k = problem.prod_offsets[c.proc]; k < problem.prod_offsets[c.proc + 1]; k++)
+            stocks[problem.prod_resources[k]] += problem.prod_amounts[k] * c.count;
+    }
+}
+
+bool Verifier::start(int proc, long long t, long long count, size_t first_line)
+{
+    completeUntil(t);
+
+    // Cuántos del lote caben: si no caben todos, falla el siguiente
+    long long runs = count;
+    int missing = -1;
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++) {
+        int amount = problem.req_amounts[k];
+        if (amount <= 0)
+            continue;
+        long long fit = stocks[problem.req_resources[k]] / amount;
+        if (fit < runs) {
+            runs = fit;
+            missing = problem.req_resources[k];
+        }
+    }
+    // Se aplican los que caben para que los stocks reflejen el fallo
+    if (runs > 0) {
+        for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++)
+            stocks[problem.req_resources[k]] -= problem.req_amounts[k] * runs;
+        long long finish = t + problem.delays[proc];
+        events.push(Completion{t + std::max(problem.delays[proc], 1), proc, runs});
+        end_time = std::max(end_time, finish);
+    }
+    if (missing < 0)
+        return true;
+
+    int amount = 0;
+    for (int k = problem.req_offsets[proc]; k < problem.req_offsets[proc + 1]; k++)
+        if (problem.req_resources[k] == missing)
+            amount = problem.req_amounts[k];
+    return fail(first_line + runs, "stock insuficiente para "
+        + problem.process_names[proc] + " en el ciclo " + std::to_string(t)
+        + ": " + problem.resource_names[missing] + " = "
+        + std::to_string(stocks[missing]) + ", necesita " + std::to_string(amount));
+}
+
+bool Verifier::run(std::string_view trace)
+{
+    size_t line_no = 0;
+    size_t pos = 0;
+
+    // Lote pendiente de líneas idénticas consecutivas
+    int batch_proc = -1;
+    long long batch_cycle = 0;
+    long long batch_count = 0;
+    size_t batch_line = 0;
+
+    while (pos < trace.size()) {
+        const char* nl = (const char*)memchr(trace.data() + pos, '\n', trace.size() - pos);
+        size_t end = nl ? (size_t)(nl - trace.data()) : trace.size();
+        std::string_view line = trace.substr(pos, end - pos);
+        pos = end + 1;
+        line_no++;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (line.empty() || line[0] < '0' || line[0] > '9') {
+            if (batch_count > 0 && !start(batch_proc, batch_cycle, batch_count, batch_line))
+                return false;
+            batch_count = 0;
+            continue;
+        }
+
+        long long t = 0;
+        auto res = std::from_chars(line.data(), line.data() + line.size(), t);
+        if (res.ec != std::errc() || res.ptr == line.data() + line.size() || *res.ptr != ':')
+            return fail(line_no, "línea mal formada: " + std::string(line));
+        std::string_view name(res.ptr + 1, line.data() + line.size() - res.ptr - 1);
+        int proc = problem.processId(name);
+        if (proc < 0)
+            return fail(line_no, "proceso desconocido: " + std::string(name));
+        if (t < cycle)
+            return fail(line_no, "ciclo " + std::to_string(t)
+                + " anterior al de la línea previa (" + std::to_string(cycle) + ")");
+        cycle = t;
+        lines++;
+
+        if (batch_count > 0 && proc == batch_proc && t == batch_cycle) {
+            batch_count++;
+            continue;
+        }
+        if (batch_count > 0 && !start(batch_proc, batch_cycle, batch_count, batch_line))
+            return false;
+        batch_proc = proc;
+        batch_cycle = t;
+        batch_count = 1;
+        batch_line = line_no;
+    }
+    if (batch_count > 0 && !start(batch_proc, batch_cycle, batch_count, batch_line))
+        return false;
+
+    // Lo de delay 0 lanzado en end_time llega un ciclo después
+    completeUntil(end_time + 1);
+    end_time = std::max(end_time, cycle);
+    return true;
+}
@@ -0,0 +1,67 @@
+#!/bin/sh
+# Regresiones: cada configuración de tests/ se ejecuta con cada motor y la
+# traza se valida con krpsim_verif. Un cuelgue cuenta como fallo. Si hay un
+# <config>.expected, los stocks finales del simulador tienen que coincidir.
+# Cada tests/reject/<config>.trace es una traza imposible que krpsim_verif
+# tiene que rechazar. Por último, ejecutar desde una caché (--compile) o
+# con una caché obsoleta (--cache de otro fichero) da la misma salida que
+# desde el texto.
+# Uso: tests/run.sh [directorio de los binarios]
+
+BIN=${1:-.}
+DIR=$(dirname "$0")
+TRACE=$(mktemp)
+OUT=$(mktemp)
+CACHE=$(mktemp)
+REF=$(mktemp)
+FAILED=0
+ENGINES="sim grasp beam"
+
+for cfg in "$DIR"/*.txt; do
+    expected="${cfg%.txt}.expected"
+    for engine in $ENGINES; do
+        if ! timeout 20 "$BIN/krpsim" "$cfg" 0.5 --engine $engine --trace "$TRACE" >"$OUT"; then
+            echo "FALLO $cfg ($engine): krpsim terminó con error o no terminó"
+            FAILED=1
+        elif ! "$BIN/krpsim_verif" "$cfg" "$TRACE" >/dev/null; then
+            echo "FALLO $cfg ($engine): traza inválida"
+            FAILED=1
+        elif [ $engine = sim ] && [ -f "$expected" ] &&
+             ! sed -n '/^Stocks finales:/,$p' "$OUT" | grep '^  ' | diff -q - "$expected" >/dev/null; then
+            echo "FALLO $cfg ($engine): stocks finales distintos de $expected"
+            FAILED=1
+        else
+            echo "ok    $cfg ($engine)"
+        fi
+    done
+done
+
+for cfg in "$DIR"/reject/*.txt; do
+    if "$BIN/krpsim_verif" "$cfg" "${cfg%.txt}.trace" >/dev/null; then
+        echo "FALLO $cfg: krpsim_verif acepta una traza imposible"
+        FAILED=1
+    else
+        echo "ok    $cfg (rechazada)"
+    fi
+done
+
+prev=""
+for cfg in "$DIR"/*.txt; do
+    "$BIN/krpsim" "$cfg" >"$REF"
+    if ! "$BIN/krpsim" "$cfg" --compile "$CACHE" >/dev/null ||
+       ! "$BIN/krpsim" "$CACHE" | cmp -s - "$REF"; then
+        echo "FALLO $cfg: la caché compilada no da la misma salida"
+        FAILED=1
+    elif [ -n "$prev" ] && { "$BIN/krpsim" "$prev" --compile "$CACHE" >/dev/null;
+         ! "$BIN/krpsim" "$cfg" --cache "$CACHE" | cmp -s - "$REF" ||
+         ! "$BIN/krpsim" "$CACHE" | cmp -s - "$REF"; }; then
+        echo "FALLO $cfg: una caché obsoleta no se regenera"
+        FAILED=1
+    else
+        echo "ok    $cfg (caché)"
+    fi
+    prev=$cfg
+done
+
+rm -f "$TRACE" "$OUT" "$CACHE" "$REF"
+exit $FAILED